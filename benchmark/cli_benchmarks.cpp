@@ -0,0 +1,373 @@
+// Copyright 2025 Dominik Czekai
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cli_app.h"
+#include "context_builder.h"
+#include "harness.h"
+#include "parsing/parser.h"
+
+// Micro-benchmarks of the hot paths of a CLI invocation: initializing the application, locating
+// the command, parsing its arguments and building the context. The schemas are generated, so the
+// suite has no dependencies besides the library.
+
+namespace bench = cli::benchmark;
+
+namespace
+{
+// leaf commands are grouped below the root, so every command path has two segments
+constexpr size_t commandsPerGroup = 100;
+// combinations of commands and options above this are skipped, they would not fit into memory
+constexpr uint64_t maxArgumentsPerSchema = 1'000'000;
+
+struct Sizes
+{
+    std::vector<uint64_t> commands{10, 1'000, 100'000};
+    std::vector<uint64_t> optionsPerCommand{1, 50, 500};
+    std::vector<uint64_t> listElements{10, 1'000, 100'000, 1'000'000};
+};
+
+std::string optionName(uint64_t index)
+{
+    return "--opt" + std::to_string(index);
+}
+
+cli::commands::Command makeLeafCommand(uint64_t index, uint64_t options)
+{
+    cli::commands::Command command("cmd" + std::to_string(index % commandsPerGroup));
+    command.withShortDescription("generated command")
+        .withPositionalArgument(cli::commands::PositionalArgument<std::string>("file"))
+        .withFlagArgument(cli::commands::FlagArgument("--verbose", "-v"))
+        .withExecutionFunc([](const cli::CliContext &) {});
+    for (uint64_t i = 0; i < options; ++i)
+    {
+        command.withOptionArgument(cli::commands::OptionArgument<int>(optionName(i), "n"));
+    }
+    return command;
+}
+
+std::unique_ptr<cli::CliApp> makeApp(uint64_t commands, uint64_t options)
+{
+    auto app = std::make_unique<cli::CliApp>(
+        cli::CliConfig{}, std::make_unique<cli::logging::Logger>(cli::logging::LogLevel::ERROR));
+    for (uint64_t group = 0; group * commandsPerGroup < commands; ++group)
+    {
+        cli::commands::Command groupCommand("group" + std::to_string(group));
+        groupCommand.withShortDescription("generated group");
+        const uint64_t end = std::min(commands, (group + 1) * commandsPerGroup);
+        for (uint64_t i = group * commandsPerGroup; i < end; ++i)
+        {
+            groupCommand.withSubCommand(makeLeafCommand(i, options));
+        }
+        app->withCommand(std::move(groupCommand));
+    }
+    return app;
+}
+
+std::unique_ptr<cli::CliApp> makeListApp()
+{
+    auto app = std::make_unique<cli::CliApp>(
+        cli::CliConfig{}, std::make_unique<cli::logging::Logger>(cli::logging::LogLevel::ERROR));
+    app->withCommand(std::move(
+        cli::commands::Command("sum")
+            .withOptionArgument(
+                cli::commands::OptionArgument<int>("--values", "n").withRepeatable(true))
+            .withExecutionFunc([](const cli::CliContext &) {})));
+    return app;
+}
+
+// the first command of the first group
+cli::commands::Command &firstCommand(const cli::CliApp &app)
+{
+    const std::array<std::string_view, 2> path{"group0", "cmd0"};
+    size_t consumed = 0;
+    return *app.getCommandTree().locate(path, consumed);
+}
+
+// arguments that set every option of a generated command
+std::vector<std::string> makeInputs(uint64_t options)
+{
+    std::vector<std::string> inputs{"file.txt", "--verbose"};
+    for (uint64_t i = 0; i < options; ++i)
+    {
+        inputs.push_back(optionName(i));
+        inputs.push_back(std::to_string(i));
+    }
+    return inputs;
+}
+
+std::vector<std::string_view> viewsOf(const std::vector<std::string> &strings)
+{
+    return {strings.begin(), strings.end()};
+}
+
+void benchmarkInit(bench::Harness &harness, const Sizes &sizes)
+{
+    for (const uint64_t commands : sizes.commands)
+    {
+        for (const uint64_t options : sizes.optionsPerCommand)
+        {
+            if (commands * options > maxArgumentsPerSchema)
+            {
+                continue;
+            }
+            harness.run(
+                "init", {{"commands", commands}, {"options_per_command", options}},
+                [&] { return makeApp(commands, options); },
+                [](std::unique_ptr<cli::CliApp> &app) { app->init(); });
+        }
+    }
+}
+
+// the same sizes as init, so both can be compared directly
+void benchmarkLoadSnapshot(bench::Harness &harness, const Sizes &sizes)
+{
+    if (!harness.isSelected("load_snapshot"))
+    {
+        return;
+    }
+    for (const uint64_t commands : sizes.commands)
+    {
+        for (const uint64_t options : sizes.optionsPerCommand)
+        {
+            if (commands * options > maxArgumentsPerSchema)
+            {
+                continue;
+            }
+            const std::string blob = makeApp(commands, options)->saveSchemaSnapshot();
+            harness.run(
+                "load_snapshot", {{"commands", commands}, {"options_per_command", options}},
+                [&] { return makeApp(commands, options); },
+                [&blob](std::unique_ptr<cli::CliApp> &app) { app->loadSchemaSnapshot(blob); });
+        }
+    }
+}
+
+void benchmarkLocate(bench::Harness &harness, const Sizes &sizes)
+{
+    for (const uint64_t commands : sizes.commands)
+    {
+        if (!harness.isSelected("locate"))
+        {
+            return;
+        }
+        auto app = makeApp(commands, 1);
+        app->init();
+
+        // a spread of paths, so the lookups are not served from a single cache line
+        const uint64_t pathCount = std::min<uint64_t>(commands, 1024);
+        std::vector<std::string> segments;
+        for (uint64_t i = 0; i < pathCount; ++i)
+        {
+            const uint64_t command = i * commands / pathCount;
+            segments.push_back("group" + std::to_string(command / commandsPerGroup));
+            segments.push_back("cmd" + std::to_string(command % commandsPerGroup));
+        }
+        const auto views = viewsOf(segments);
+
+        size_t next = 0;
+        harness.run("locate", {{"commands", commands}}, [&] {
+            size_t consumed = 0;
+            const auto path = std::span<const std::string_view>(views).subspan(next * 2, 2);
+            bench::doNotOptimize(app->getCommandTree().locate(path, consumed));
+            next = next + 1 == pathCount ? 0 : next + 1;
+        });
+    }
+}
+
+void benchmarkComplete(bench::Harness &harness, const Sizes &sizes)
+{
+    // what the shell waits for, the application is not initialized for a completion
+    const std::array<std::string_view, 2> words{"group0", "cmd"};
+    for (const uint64_t commands : sizes.commands)
+    {
+        if (!harness.isSelected("complete"))
+        {
+            return;
+        }
+        auto app = makeApp(commands, 1);
+        harness.run("complete", {{"commands", commands}},
+                    [&] { bench::doNotOptimize(app->complete(words)); });
+    }
+}
+
+void benchmarkParse(bench::Harness &harness, const Sizes &sizes)
+{
+    for (const uint64_t options : sizes.optionsPerCommand)
+    {
+        if (!harness.isSelected("parse"))
+        {
+            return;
+        }
+        auto app = makeApp(1, options);
+        app->init();
+        const cli::commands::Command &command = firstCommand(*app);
+        const auto inputs = makeInputs(options);
+        const auto views = viewsOf(inputs);
+        const cli::parsing::Parser parser(app->getConfig());
+
+        harness.run("parse", {{"options_per_command", options}}, [&] {
+            cli::ContextBuilder builder(command.getArgumentIndex());
+            parser.parseArguments(command, views, builder);
+            bench::doNotOptimize(builder);
+        });
+    }
+}
+
+void benchmarkBuild(bench::Harness &harness, const Sizes &sizes)
+{
+    struct State
+    {
+        cli::ContextBuilder builder;
+        std::unique_ptr<cli::CliContext> context;
+    };
+
+    for (const uint64_t options : sizes.optionsPerCommand)
+    {
+        if (!harness.isSelected("build"))
+        {
+            return;
+        }
+        auto app = makeApp(1, options);
+        app->init();
+        const cli::commands::Command &command = firstCommand(*app);
+        const auto inputs = makeInputs(options);
+        const auto views = viewsOf(inputs);
+        const cli::parsing::Parser parser(app->getConfig());
+
+        harness.run(
+            "build", {{"options_per_command", options}},
+            [&] {
+                State state{cli::ContextBuilder(command.getArgumentIndex()), nullptr};
+                parser.parseArguments(command, views, state.builder);
+                return state;
+            },
+            [&](State &state) { state.context = state.builder.build(app->Logger()); });
+    }
+}
+
+void benchmarkParseList(bench::Harness &harness, const Sizes &sizes)
+{
+    for (const uint64_t elements : sizes.listElements)
+    {
+        if (!harness.isSelected("parse_list"))
+        {
+            return;
+        }
+        auto app = makeListApp();
+        app->init();
+        const std::array<std::string_view, 1> path{"sum"};
+        size_t consumed = 0;
+        const cli::commands::Command &command = *app->getCommandTree().locate(path, consumed);
+
+        std::string list;
+        for (uint64_t i = 0; i < elements; ++i)
+        {
+            list += (i == 0 ? "" : ",") + std::to_string(i % 1000);
+        }
+        const std::array<std::string_view, 2> inputs{"--values", list};
+        const cli::parsing::Parser parser(app->getConfig());
+
+        harness.run("parse_list", {{"elements", elements}}, [&] {
+            cli::ContextBuilder builder(command.getArgumentIndex());
+            parser.parseArguments(command, inputs, builder);
+            bench::doNotOptimize(builder);
+        });
+    }
+}
+
+void printUsage()
+{
+    std::cerr << "usage: cli_benchmarks [--quick] [--filter <text>] [--min-time-ms <ms>] "
+                 "[--output <file>]\n"
+                 "  --quick        run every benchmark once on small schemas (smoke test)\n"
+                 "  --filter       only run benchmarks whose name contains the text\n"
+                 "  --min-time-ms  minimum measured time per benchmark, default 200\n"
+                 "  --output       write the JSON results to a file instead of stdout\n";
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    bench::Options options;
+    Sizes sizes;
+    std::string outputPath;
+
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
+    for (size_t i = 0; i < args.size(); ++i)
+    {
+        const bool hasValue = i + 1 < args.size();
+        if (args[i] == "--quick")
+        {
+            options.minTime = std::chrono::nanoseconds(0);
+            sizes.commands = {10, 1'000};
+            sizes.optionsPerCommand = {1, 50};
+            sizes.listElements = {10, 1'000};
+        }
+        else if (args[i] == "--filter" && hasValue)
+        {
+            options.filter = args[++i];
+        }
+        else if (args[i] == "--min-time-ms" && hasValue)
+        {
+            const std::string_view value = args[++i];
+            uint64_t milliseconds = 0;
+            if (std::from_chars(value.data(), value.data() + value.size(), milliseconds).ec !=
+                std::errc{})
+            {
+                printUsage();
+                return EXIT_FAILURE;
+            }
+            options.minTime = std::chrono::milliseconds(milliseconds);
+        }
+        else if (args[i] == "--output" && hasValue)
+        {
+            outputPath = args[++i];
+        }
+        else
+        {
+            printUsage();
+            return args[i] == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    bench::Harness harness(options);
+    benchmarkInit(harness, sizes);
+    benchmarkLoadSnapshot(harness, sizes);
+    benchmarkLocate(harness, sizes);
+    benchmarkComplete(harness, sizes);
+    benchmarkParse(harness, sizes);
+    benchmarkBuild(harness, sizes);
+    benchmarkParseList(harness, sizes);
+
+    if (outputPath.empty())
+    {
+        harness.writeJson(std::cout);
+        return EXIT_SUCCESS;
+    }
+    std::ofstream output(outputPath);
+    harness.writeJson(output);
+    return output ? EXIT_SUCCESS : EXIT_FAILURE;
+}
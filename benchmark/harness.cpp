@@ -0,0 +1,88 @@
+// Copyright 2025 Dominik Czekai
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "harness.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace cli::benchmark
+{
+namespace detail
+{
+void writeJsonString(std::ostream &out, std::string_view text)
+{
+    out << '"';
+    for (const char ch : text)
+    {
+        if (ch == '"' || ch == '\\')
+        {
+            out << '\\';
+        }
+        out << ch;
+    }
+    out << '"';
+}
+} // namespace detail
+
+uint64_t Harness::nextIterations(uint64_t iterations, std::chrono::nanoseconds elapsed) const
+{
+    // aim slightly above the minimum time, but grow at least 2x and at most 10x per round
+    double factor = 10.0;
+    if (elapsed.count() > 0)
+    {
+        factor = std::clamp(1.4 * static_cast<double>(options.minTime.count()) /
+                                static_cast<double>(elapsed.count()),
+                            2.0, 10.0);
+    }
+    return std::min(options.maxIterations,
+                    static_cast<uint64_t>(static_cast<double>(iterations) * factor));
+}
+
+void Harness::record(std::string name, Parameters parameters, uint64_t iterations,
+                     const Sample &measured)
+{
+    const auto perOp = [iterations](uint64_t total) {
+        return static_cast<double>(total) / static_cast<double>(iterations);
+    };
+    results.push_back(Result{std::move(name), std::move(parameters), iterations,
+                             perOp(static_cast<uint64_t>(measured.elapsed.count())),
+                             perOp(measured.allocations.allocations),
+                             perOp(measured.allocations.bytes)});
+}
+
+void Harness::writeJson(std::ostream &out) const
+{
+    out << "{\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result &result = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+        detail::writeJsonString(out, result.name);
+        out << ", \"parameters\": {";
+        for (size_t j = 0; j < result.parameters.size(); ++j)
+        {
+            out << (j == 0 ? "" : ", ");
+            detail::writeJsonString(out, result.parameters[j].first);
+            out << ": " << result.parameters[j].second;
+        }
+        out << "}, \"iterations\": " << result.iterations << std::fixed << std::setprecision(2)
+            << ", \"ns_per_op\": " << result.nsPerOp
+            << ", \"allocations_per_op\": " << result.allocationsPerOp
+            << ", \"bytes_per_op\": " << result.bytesPerOp << "}";
+        out.unsetf(std::ios_base::floatfield);
+    }
+    out << "\n  ]\n}\n";
+}
+} // namespace cli::benchmark
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "allocation_counter.h"
+
+namespace cli::benchmark
+{
+/// @brief Number of allocations and allocated bytes since the start of the process.
+using AllocationCount = allocations::AllocationCount;
+
+/// @brief Read the counters of the replaced global operator new (see the allocation_counter
+/// target).
+/// @return The allocations made so far by all threads.
+inline AllocationCount currentAllocations() noexcept { return allocations::processAllocations(); }
+
+/// @brief Keep the compiler from optimizing away the computation of a value.
+/// @param value The value that has to be materialized.
+template <typename T>
+inline void doNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void *volatile sink;
+    sink = &value;
+#endif
+}
+
+/// @brief Settings of a benchmark run, set from the command line.
+struct Options
+{
+    /// @brief Minimum measured time per benchmark, iterations are added until it is reached.
+    std::chrono::nanoseconds minTime{std::chrono::milliseconds(200)};
+    /// @brief Upper limit of the iterations per benchmark.
+    uint64_t maxIterations{1'000'000'000};
+    /// @brief Only benchmarks whose name contains this string are run.
+    std::string filter;
+};
+
+/// @brief Measurement of a single benchmark.
+struct Result
+{
+    std::string name;
+    std::vector<std::pair<std::string, uint64_t>> parameters;
+    uint64_t iterations;
+    double nsPerOp;
+    double allocationsPerOp;
+    double bytesPerOp;
+};
+
+/// @brief Runs benchmarks and collects their results.
+/// @details Every benchmark is calibrated by running it with a growing number of iterations until
+/// the measured time exceeds Options::minTime. Allocations are counted with the replaced global
+/// operator new, so they include those of the standard library.
+class Harness
+{
+public:
+    /// @brief Parameters of a benchmark, e.g. the size of the generated schema.
+    using Parameters = std::vector<std::pair<std::string, uint64_t>>;
+
+    /// @brief Create a harness with the given options.
+    /// @param options The options of the run.
+    explicit Harness(Options options) : options(std::move(options)) {}
+
+    /// @brief Check if a benchmark is selected by the filter of the options.
+    /// @param name The name of the benchmark.
+    /// @return True if the benchmark should be run.
+    [[nodiscard]] bool isSelected(std::string_view name) const
+    {
+        return name.find(options.filter) != std::string_view::npos;
+    }
+
+    /// @brief Measure a benchmark that needs no preparation per iteration.
+    /// @details All iterations are timed together, so the overhead of the clock is not measured.
+    /// @param name The name of the benchmark.
+    /// @param parameters The parameters the benchmark was run with.
+    /// @param body The operation to measure.
+    template <typename Body>
+    void run(std::string name, Parameters parameters, Body &&body)
+    {
+        if (!isSelected(name))
+        {
+            return;
+        }
+        measure(std::move(name), std::move(parameters), [&](uint64_t iterations) {
+            const auto allocationsBefore = currentAllocations();
+            const auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                body();
+            }
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            return Sample{elapsed, difference(allocationsBefore, currentAllocations())};
+        });
+    }
+
+    /// @brief Measure a benchmark that consumes a freshly prepared state in every iteration.
+    /// @details Only the body is timed and counted, the setup and the destruction of the state
+    /// are not. Every iteration is timed on its own, so the operation should take at least a few
+    /// microseconds for the clock overhead to be negligible.
+    /// @param name The name of the benchmark.
+    /// @param parameters The parameters the benchmark was run with.
+    /// @param setup Creates the state for one iteration.
+    /// @param body The operation to measure, called with a reference to the state.
+    template <typename Setup, typename Body>
+    void run(std::string name, Parameters parameters, Setup &&setup, Body &&body)
+    {
+        if (!isSelected(name))
+        {
+            return;
+        }
+        measure(std::move(name), std::move(parameters), [&](uint64_t iterations) {
+            Sample total{std::chrono::nanoseconds(0), AllocationCount{0, 0}};
+            for (uint64_t i = 0; i < iterations; ++i)
+            {
+                auto state = setup();
+                const auto allocationsBefore = currentAllocations();
+                const auto start = std::chrono::steady_clock::now();
+                body(state);
+                const auto elapsed = std::chrono::steady_clock::now() - start;
+                const auto allocations = difference(allocationsBefore, currentAllocations());
+                total.elapsed += elapsed;
+                total.allocations.allocations += allocations.allocations;
+                total.allocations.bytes += allocations.bytes;
+            }
+            return total;
+        });
+    }
+
+    /// @brief Get the results of all benchmarks run so far.
+    /// @return The results in the order the benchmarks were run.
+    [[nodiscard]] const std::vector<Result> &getResults() const { return results; }
+
+    /// @brief Write the results as a JSON document.
+    /// @param out The stream to write to.
+    void writeJson(std::ostream &out) const;
+
+private:
+    struct Sample
+    {
+        std::chrono::nanoseconds elapsed;
+        AllocationCount allocations;
+    };
+
+    static AllocationCount difference(AllocationCount before, AllocationCount after) noexcept
+    {
+        return AllocationCount{after.allocations - before.allocations, after.bytes - before.bytes};
+    }
+
+    template <typename Sampler>
+    void measure(std::string name, Parameters parameters, Sampler &&sample)
+    {
+        uint64_t iterations = 1;
+        while (true)
+        {
+            const Sample measured = sample(iterations);
+            if (measured.elapsed >= options.minTime || iterations >= options.maxIterations)
+            {
+                record(std::move(name), std::move(parameters), iterations, measured);
+                return;
+            }
+            iterations = nextIterations(iterations, measured.elapsed);
+        }
+    }
+
+    uint64_t nextIterations(uint64_t iterations, std::chrono::nanoseconds elapsed) const;
+
+    void record(std::string name, Parameters parameters, uint64_t iterations,
+                const Sample &measured);
+
+    Options options;
+    std::vector<Result> results;
+};
+} // namespace cli::benchmark
@@ -63,7 +63,7 @@ public:
     CustomAppDocFormatter() = default;
 
     std::string generateAppDocString(const cli::CliConfig &configuration,
-    const std::vector<const cli::commands::Command *> &commands) override
+    const std::vector<const cli::commands::Command *> &commands) const override
 {
     std::ostringstream builder;
     builder << configuration.description << " - from own formatter\n\n";
@@ -79,7 +79,7 @@ public:
 }
 
 std::string generateCommandDocString(const cli::commands::Command &command,
-                                                                const cli::CliConfig &configuration) override
+                                                                const cli::CliConfig &configuration) const override
 {
     std::ostringstream builder;
     builder << "USAGE\n" << configuration.executableName << " " << command.getDocStringLong() << "\n\n";
@@ -87,7 +87,7 @@ std::string generateCommandDocString(const cli::commands::Command &command,
     return builder.str();
 }
 
-std::string generateAppVersionString(const cli::CliConfig &configuration) override
+std::string generateAppVersionString(const cli::CliConfig &configuration) const override
 {
     return std::format("{} version from own formatter: {}", configuration.executableName, configuration.version);
 }
@@ -97,7 +97,7 @@ class CustomOptionFormatter : public cli::commands::docwriting::DefaultOptionFor
 {
 public:
     std::string generateArgDocString(const cli::commands::OptionArgumentBase &argument,
-                                     const cli::CliConfig &configuration) override
+                                     const cli::CliConfig &configuration) const override
     {
         std::ostringstream builder;
         builder << "[Option: " << argument.getName();
@@ -110,7 +110,7 @@ public:
     }
 
     std::string generateOptionsDocString(const cli::commands::OptionArgumentBase &argument,
-                                         const cli::CliConfig &configuration) override
+                                         const cli::CliConfig &configuration) const override
     {
         std::ostringstream builder;
         builder << DefaultOptionFormatter::generateOptionsDocString(argument, configuration);
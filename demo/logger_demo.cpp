@@ -32,6 +32,9 @@ int main(int argc, char *argv[])
     constexpr double debugY = 3.54;
     cliApp.Logger().debug("Debug details: x = {}, y = {}", debugX, debugY);
 
+    // formatting is left to the logger, e.g. the AsyncLogger formats on its writer thread
+    cliApp.Logger().logDeferred(cli::logging::LogLevel::DEBUG, "Deferred details: x = {}", debugX);
+
     cliApp.Logger().error("An error occurred: {}", "File not found");
     cliApp.Logger().success("Logging demo completed successfully.");
 
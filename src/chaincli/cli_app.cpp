@@ -14,12 +14,16 @@
 
 #include "cli_app.h"
 
+#include <format>
 #include <iostream>
 
 #include "cli_context.h"
 #include "commands/command.h"
+#include "commands/schema_snapshot.h"
+#include "commands/suggestion_index.h"
 #include "context_builder.h"
 #include "logging/logger.h"
+#include "parsing/command_line.h"
 
 #define inline_t
 
@@ -66,14 +70,66 @@ inline_t void CliApp::init()
 #endif
     initialized = true;
 
+    commandsTree.freeze();
     commandsTree.buildCommandPathMap();
 
 #ifdef CHAIN_CLI_VERBOSE
-    std::cout << "Building documentation strings for commands...\n";
+    std::cout << "Building argument indices and binding documentation for commands...\n";
 #endif
+    // doc strings are only rendered when help is actually printed, unless configured otherwise
     commandsTree.forEachCommand([this](commands::Command *cmd) {
-        docWriter.setDocStrings(*cmd, commandsTree.getPathForCommand(cmd));
+        cmd->buildArgumentIndex();
+        docWriter.bindDocStrings(*cmd, commandsTree.getPathForCommand(cmd));
     });
+
+    if (configuration->eagerDocStrings)
+    {
+#ifdef CHAIN_CLI_VERBOSE
+        std::cout << "Rendering documentation strings with " << configuration->docRenderingThreads
+                  << " threads...\n";
+#endif
+        const auto allCommands = commandsTree.getAllCommands();
+        std::vector<std::string_view> paths;
+        paths.reserve(allCommands.size());
+        for (auto *cmd : allCommands)
+        {
+            paths.push_back(commandsTree.getPathForCommand(cmd));
+        }
+        docWriter.setDocStrings(allCommands, paths, configuration->docRenderingThreads);
+    }
+}
+
+inline_t std::string CliApp::saveSchemaSnapshot()
+{
+    if (!initialized)
+    {
+        init();
+    }
+    // an application loaded from a snapshot never needed the paths
+    if (!commandsTree.hasCommandPaths())
+    {
+        commandsTree.buildCommandPathMap();
+    }
+    return commands::SchemaSnapshot::capture(commandsTree, *configuration);
+}
+
+inline_t void CliApp::loadSchemaSnapshot(std::string_view blob)
+{
+    // the argument section is only needed to inspect a snapshot, the hash covers it as well as
+    // the descriptions and configuration the help was rendered from
+    const auto snapshot = commands::SchemaSnapshot::loadHeader(blob);
+    snapshot.verify(commandsTree, *configuration);
+
+    commandsTree.freeze();
+
+    // the snapshot lists the commands in the same depth-first order as the traversal, the help
+    // stays in the blob
+    size_t index = 0;
+    commandsTree.forEachCommand([this, &snapshot, &index](commands::Command *cmd) {
+        const auto &entry = snapshot.getCommands()[index++];
+        docWriter.setRenderedDocStrings(*cmd, entry.docStringShort, entry.docStringLong);
+    });
+    initialized = true;
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
@@ -87,19 +143,76 @@ inline_t int CliApp::run(int argc, char *argv[])
     }
     std::cout << "\n";
 #endif
+    std::pmr::monotonic_buffer_resource arena(
+        memoryResource ? memoryResource : std::pmr::get_default_resource());
+    std::pmr::memory_resource *resource = memoryResource ? &arena : std::pmr::get_default_resource();
+
+    // only views are created, the argument strings themselves are never copied
+    std::pmr::vector<std::string_view> args(resource);
+    if (argc > 1)
+    {
+        args.assign(argv + 1, argv + argc);
+    }
+    return internalRun(args, resource);
+}
+
+inline_t int CliApp::run(std::span<const std::string_view> args)
+{
+    std::pmr::monotonic_buffer_resource arena(
+        memoryResource ? memoryResource : std::pmr::get_default_resource());
+    std::pmr::memory_resource *resource = memoryResource ? &arena : std::pmr::get_default_resource();
+    return internalRun(args, resource);
+}
+
+inline_t int CliApp::runBatch(std::istream &input)
+{
     if (!initialized)
     {
-#ifdef CHAIN_CLI_VERBOSE
-        std::cout << "Application not initialized, initializing now...\n";
-#endif
         init();
     }
-    return internalRun(std::span<char *const>(argv + 1, argc - 1));
+
+    std::pmr::monotonic_buffer_resource arena(
+        memoryResource ? memoryResource : std::pmr::get_default_resource());
+    std::string line;
+    size_t lineNumber = 0;
+    size_t failedLines = 0;
+    while (std::getline(input, line))
+    {
+        ++lineNumber;
+        // nothing of the previous line is alive anymore, so its memory is dropped at once
+        arena.release();
+        std::pmr::string storage(&arena);
+        std::pmr::vector<std::string_view> args(&arena);
+
+        try
+        {
+            parsing::splitCommandLine(line, storage, args);
+            if (args.empty())
+            {
+                continue;
+            }
+            if (internalRun(args, &arena) != 0)
+            {
+                // the failure itself was already logged by internalRun
+                ++failedLines;
+                logger->error() << "line " << lineNumber << ": failed\n" << std::flush;
+                continue;
+            }
+            logger->verbose() << "line " << lineNumber << ": ok\n" << std::flush;
+        }
+        catch (const std::exception &e)
+        {
+            ++failedLines;
+            logger->error() << "line " << lineNumber << ": " << e.what() << "\n" << std::flush;
+        }
+    }
+    return failedLines == 0 ? 0 : 1;
 }
 
-// returns the found command and modifies args to only contain the values that
+// returns the found command and narrows args to only contain the values that
 // werent consumed in the tree traversal
-inline_t commands::Command *locateCommand(commands::CommandTree &commandsTree, std::vector<std::string> &args)
+inline_t commands::Command *locateCommand(commands::CommandTree &commandsTree,
+                                          std::span<const std::string_view> &args)
 {
 #ifdef CHAIN_CLI_VERBOSE
     std::cout << "Locating command in tree with arguments: ";
@@ -108,23 +221,9 @@ inline_t commands::Command *locateCommand(commands::CommandTree &commandsTree, s
     }
     std::cout << "\n";
 #endif
-    commands::Command *commandPtr = commandsTree.getRootCommand();
-
-    int consumed = 0;
-
-    for (const auto &arg : args)
-    {
-        // Move one level down if child exists
-        commands::Command *subCommandPtr = commandPtr->getSubCommand(arg);
-        if (!subCommandPtr)
-        {
-            break;
-        }
-        
-        commandPtr = subCommandPtr;
-        ++consumed;
-    }
-    args.erase(args.begin(), args.begin() + consumed);
+    size_t consumed = 0;
+    commands::Command *commandPtr = commandsTree.locate(args, consumed);
+    args = args.subspan(consumed);
 #ifdef CHAIN_CLI_VERBOSE
     std::cout << "Located command: " << commandPtr->getIdentifier() << ", consumed " << consumed << " arguments\n";
     std::cout << "Remaining arguments: ";
@@ -136,11 +235,46 @@ inline_t commands::Command *locateCommand(commands::CommandTree &commandsTree, s
     return commandPtr;
 }
 
-inline_t int CliApp::internalRun(std::span<char *const> args)
+inline_t std::vector<commands::CompletionCandidate> CliApp::complete(
+    std::span<const std::string_view> words)
+{
+    return commands::Completer(commandsTree).complete(words);
+}
+
+inline_t int CliApp::runCompletion(std::span<const std::string_view> args)
+{
+    if (args.size() == 2 && args[0] == "--script")
+    {
+        commands::Completer::writeScript(std::cout, args[1], configuration->executableName);
+        return 0;
+    }
+    if (!args.empty() && args[0] == "--")
+    {
+        args = args.subspan(1);
+    }
+    commands::Completer::writeCandidates(std::cout, complete(args));
+    std::cout << std::flush;
+    return 0;
+}
+
+inline_t int CliApp::internalRun(std::span<const std::string_view> args,
+                                  std::pmr::memory_resource *resource)
 {
-    std::vector<std::string> argVec(args.begin(), args.end());
+    // handled before the initialization, completions have to be instant even for huge trees
+    if (!args.empty() && args[0] == "__complete")
+    {
+        return runCompletion(args.subspan(1));
+    }
 
-    if (rootShortCircuits(argVec, *(commandsTree.getRootCommand())))
+    if (!initialized)
+    {
+#ifdef CHAIN_CLI_VERBOSE
+        std::cout << "Application not initialized, initializing now...\n";
+#endif
+        init();
+    }
+
+    if (rootShortCircuits(args, *(commandsTree.getRootCommand())))
     {
 #ifdef CHAIN_CLI_VERBOSE
         std::cout << "Root short-circuit triggered, exiting early\n";
@@ -148,10 +282,11 @@ inline_t int CliApp::internalRun(std::span<char *const> args)
         return 0;
     }
 
-    if (const commands::Command *cmd = locateCommand(commandsTree, argVec);
+    std::span<const std::string_view> remainingArgs = args;
+    if (const commands::Command *cmd = locateCommand(commandsTree, remainingArgs);
         cmd && cmd->hasExecutionFunction())
     {
-        if (commandShortCircuits(argVec, cmd))
+        if (commandShortCircuits(remainingArgs, cmd))
         {
 #ifdef CHAIN_CLI_VERBOSE
             std::cout << "Command short-circuit triggered for: " << cmd->getIdentifier() << "\n";
@@ -163,31 +298,59 @@ inline_t int CliApp::internalRun(std::span<char *const> args)
         std::cout << "Executing command: " << cmd->getIdentifier() << "\n";
         #endif
 
-        auto contextBuilder = cli::ContextBuilder();
+        if (cmd->hasOwnParser())
+        {
+            cmd->executeWithOwnParser(remainingArgs, *logger, configuration->suggestionLimit);
+            return 0;
+        }
+
+        auto contextBuilder = cli::ContextBuilder(cmd->getArgumentIndex(), resource);
 
 #ifdef CHAIN_CLI_VERBOSE
         std::cout << "Parsing arguments for command execution...\n";
 #endif
-        parser.parseArguments(*cmd, argVec, contextBuilder);
+        parser.parseArguments(*cmd, remainingArgs, contextBuilder);
 #ifdef CHAIN_CLI_VERBOSE
         std::cout << "Building context and executing command...\n";
 #endif
-        cmd->execute(*contextBuilder.build(*logger));
+        const CliContext context = contextBuilder.buildContext(*logger);
+        cmd->execute(context);
     }
     else
     {
 #ifdef CHAIN_CLI_VERBOSE
         std::cout << "No valid command found or command has no execution function\n";
 #endif
-        logger->error() << "Unknown command: " << args[0] << "\n" << std::flush;
-        auto allCommands = commandsTree.getAllCommandsConst();
-        logger->info(docWriter.generateAppDocString(allCommands));
+        // the first argument that is not a subcommand of the located one is the unknown one
+        const std::string_view unknown = remainingArgs.empty() ? args[0] : remainingArgs[0];
+        std::string message = std::format("Unknown command: {}\n", unknown);
+        if (cmd && !remainingArgs.empty())
+        {
+            if (const auto suggestions = commands::formatSuggestions(
+                    commandsTree.suggest(*cmd, unknown, configuration->suggestionLimit));
+                !suggestions.empty())
+            {
+                message += suggestions + "\n";
+            }
+        }
+        logger->error() << message << std::flush;
+
+        if (configuration->helpOnUnknownCommand)
+        {
+            auto allCommands = commandsTree.getAllCommandsConst();
+            logger->info(docWriter.generateAppDocString(allCommands));
+        }
+        else
+        {
+            logger->info("Run with --help to list all commands\n");
+        }
+        return 1;
     }
     return 0;
 }
 
-inline_t bool CliApp::rootShortCircuits(std::vector<std::string> &args,
-                               const cli::commands::Command &cmd) const
+inline_t bool CliApp::rootShortCircuits(std::span<const std::string_view> args,
+                                        const cli::commands::Command &cmd) const
 {
     if (args.empty() && !cmd.hasExecutionFunction())
     {
@@ -198,13 +361,13 @@ inline_t bool CliApp::rootShortCircuits(std::vector<std::string> &args,
 
     if (args.size() == 1)
     {
-        if (args.at(0) == "-h" || args.at(0) == "--help")
+        if (args[0] == "-h" || args[0] == "--help")
         {
             auto allCommands = commandsTree.getAllCommandsConst();
             logger->info(docWriter.generateAppDocString(allCommands));
             return true;
         }
-        else if (args.at(0) == "-v" || args.at(0) == "--version")
+        else if (args[0] == "-v" || args[0] == "--version")
         {
             logger->info(docWriter.generateAppVersionString());
             return true;
@@ -213,10 +376,10 @@ inline_t bool CliApp::rootShortCircuits(std::vector<std::string> &args,
     return false;
 }
 
-inline_t bool CliApp::commandShortCircuits(std::vector<std::string> &args,
-                                  const cli::commands::Command *cmd) const
+inline_t bool CliApp::commandShortCircuits(std::span<const std::string_view> args,
+                                           const cli::commands::Command *cmd) const
 {
-    if (args.size() == 1 && (args.at(0) == "-h" || args.at(0) == "--help"))
+    if (args.size() == 1 && (args[0] == "-h" || args[0] == "--help"))
     {
         logger->info(std::string(docWriter.generateCommandDocString(*cmd)));
         return true;
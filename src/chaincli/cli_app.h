@@ -15,13 +15,18 @@
  */
 
 #pragma once
+#include <istream>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "cli_config.h"
 #include "commands/command_tree.h"
+#include "commands/completion.h"
 #include "commands/docwriting/docwriting.h"
 #include "logging/logger.h"
 #include "parsing/parser.h"
@@ -74,6 +79,52 @@ public:
     /// @return the exit code of the application
     int run(int argc, char *argv[]);
 
+    /// @brief Run the CLI application with the given, already split arguments
+    /// @details The arguments are only viewed, not copied, and have to stay alive until the
+    /// executed command returns.
+    /// @param args the arguments without the executable name (e.g argv[1] to argv[argc - 1])
+    /// @return the exit code of the application, 1 if the arguments name an unknown command
+    int run(std::span<const std::string_view> args);
+
+    /// @brief Run the CLI application once for every command line read from a stream
+    /// @details Each line is split into arguments like a shell would (see
+    /// parsing::splitCommandLine) and dispatched exactly like a call to `run()`, but the
+    /// application is only initialized once for all of them. Blank lines and lines starting with
+    /// '#' are skipped. A failing line does not stop the batch: its error is logged with the line
+    /// number at error level, every successful line is reported at verbose level. All state of a
+    /// line is allocated from an arena that is released before the next line is read.
+    /// @param input the stream to read the command lines from
+    /// @return 0 if every line succeeded, 1 if at least one line failed (including lines naming
+    /// an unknown command)
+    int runBatch(std::istream &input);
+
+    /// @brief Serialize the schema of the application into a snapshot blob
+    /// @details The snapshot contains the command hierarchy, the argument metadata and groups as
+    /// well as the rendered help of every command (see commands::SchemaSnapshot). The application
+    /// is initialized first if it was not yet.
+    /// @return the snapshot blob
+    std::string saveSchemaSnapshot();
+
+    /// @brief Initialize the application from a schema snapshot instead of calling `init()`
+    /// @details The commands have to be added as usual since their argument types and execution
+    /// functions are not part of the snapshot, but the rendered help is taken from the snapshot
+    /// and the argument indices of the commands are only built for the command that is executed.
+    /// The commands are checked against the schema hash stored in the snapshot and the help is not
+    /// copied, so the blob has to outlive the application.
+    /// @param blob the snapshot created by saveSchemaSnapshot for the same commands
+    /// @throws commands::SchemaSnapshotException if the blob is malformed or the commands of the
+    /// application differ from the ones in the snapshot
+    void loadSchemaSnapshot(std::string_view blob);
+
+    /// @brief Compute the shell completions for a partial command line
+    /// @details The application is not initialized for this, only the located command is read.
+    /// `run()` answers the hidden `__complete -- <words>` command with these candidates (one per
+    /// line, value and description separated by a tab) and `__complete --script <shell>` with a
+    /// completion script for bash, zsh or fish that calls it (see commands::Completer).
+    /// @param words the words after the executable name, the last one is the word being completed
+    /// @return the matching subcommands or options
+    std::vector<commands::CompletionCandidate> complete(std::span<const std::string_view> words);
+
     /// @brief Get the logger instance used by the CLI application
     /// @return a reference to the logger instance
     [[nodiscard]] logging::AbstractLogger &Logger() { return *logger; }
@@ -98,15 +149,27 @@ public:
     /// @param newLogger the new logger instance
     void setLogger(std::unique_ptr<logging::Logger> &&newLogger) { logger = std::move(newLogger); }
 
+    /// @brief Set the memory resource the state of each invocation of `run()` is allocated from
+    /// @details If set, every invocation creates a monotonic arena on top of the resource that the
+    /// argument views, the context builder, the context and the lists of repeatable values are
+    /// allocated from. The arena is released at once after the executed command returned.
+    /// @param resource the upstream resource of the arenas or nullptr to allocate from the default
+    /// resource without an arena
+    void setMemoryResource(std::pmr::memory_resource *resource) { memoryResource = resource; }
+
 private:
-    int internalRun(std::span<char *const> args);
-    bool rootShortCircuits(std::vector<std::string> &args, const cli::commands::Command &cmd) const;
-    bool commandShortCircuits(std::vector<std::string> &args, const cli::commands::Command *cmd) const;
+    int internalRun(std::span<const std::string_view> args, std::pmr::memory_resource *resource);
+    int runCompletion(std::span<const std::string_view> args);
+    bool rootShortCircuits(std::span<const std::string_view> args,
+                           const cli::commands::Command &cmd) const;
+    bool commandShortCircuits(std::span<const std::string_view> args,
+                              const cli::commands::Command *cmd) const;
     bool initialized{false};
     commands::CommandTree commandsTree;
 
     std::unique_ptr<CliConfig> configuration;
     std::unique_ptr<logging::AbstractLogger> logger;
+    std::pmr::memory_resource *memoryResource{nullptr};
 
     parsing::Parser parser;
     cli::commands::docwriting::DocWriter docWriter;
@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <cstddef>
 #include <string>
 
 namespace cli
@@ -33,7 +34,20 @@ struct CliConfig
     int optionsWidth{20}; // width that is used to right aling the options text for arguments
 
     // Behavior toggles
-    // ...
+    // store the raw inputs in the context and convert them on first access instead of while
+    // parsing, conversion errors are then thrown by the accessors of the context and the inputs
+    // have to outlive the context (argv always does)
+    bool lazyConversion{false};
+    // render the doc strings of all commands in CliApp::init instead of when they are first
+    // printed, e.g. to export the help of every command
+    bool eagerDocStrings{false};
+    // number of threads the eager rendering is spread across, 0 uses one per hardware thread
+    unsigned docRenderingThreads{1};
+    // number of closest names suggested for an unknown command or option, 0 suggests none
+    size_t suggestionLimit{3};
+    // print the help of all commands after an unknown command, which renders the docstrings of
+    // the whole tree
+    bool helpOnUnknownCommand{false};
 };
 
 } // namespace cli
\ No newline at end of file
@@ -23,24 +23,69 @@
 namespace cli
 {
 
+inline_t size_t CliContext::slotOf(std::string_view name, commands::ArgumentKind kind) const
+{
+    const auto *entry = argumentIndex ? argumentIndex->find(name) : nullptr;
+    return entry && entry->kind == kind ? entry->slot : commands::ArgumentIndex::npos;
+}
+
+inline_t size_t CliContext::valueSlotOf(std::string_view name) const
+{
+    const auto *entry = argumentIndex ? argumentIndex->find(name) : nullptr;
+    return entry && entry->kind != commands::ArgumentKind::Flag ? entry->slot
+                                                                 : commands::ArgumentIndex::npos;
+}
+
+inline_t std::vector<std::string_view> CliContext::presentArgumentNames() const
+{
+    std::vector<std::string_view> names;
+    for (size_t slot = 0; slot < presentSlots.size(); ++slot)
+    {
+        if (presentSlots.contains(slot))
+        {
+            names.push_back(argumentIndex->slotName(slot));
+        }
+    }
+    return names;
+}
+
+inline_t std::string_view CliContext::slotName(size_t slot) const
+{
+    if (argumentIndex && slot < argumentIndex->slotCount())
+    {
+        return argumentIndex->slotName(slot);
+    }
+    return "<invalid handle>";
+}
+
+inline_t void CliContext::throwInvalidAccess(size_t slot, const std::type_info &requested) const
+{
+    std::string_view name = slotName(slot);
+    if (!presentSlots.contains(slot))
+    {
+        throw MissingArgumentException(name, presentArgumentNames());
+    }
+    throw InvalidArgumentTypeException(std::string(name), requested, values[slot].type());
+}
+
 inline_t bool CliContext::isOptionArgPresent(const std::string &argName) const
 {
-    return optionArgs->contains(argName);
+    return presentSlots.contains(slotOf(argName, commands::ArgumentKind::Option));
 }
 
 inline_t bool CliContext::isPositionalArgPresent(const std::string &argName) const
 {
-    return positionalArgs->contains(argName);
+    return presentSlots.contains(slotOf(argName, commands::ArgumentKind::Positional));
 }
 
 inline_t bool CliContext::isFlagPresent(const std::string &argName) const
 {
-    return flagArgs->contains(argName);
+    return presentSlots.contains(slotOf(argName, commands::ArgumentKind::Flag));
 }
 
 inline_t bool CliContext::isArgPresent(const std::string &argName) const
 {
-    return isOptionArgPresent(argName) || isFlagPresent(argName) || isPositionalArgPresent(argName);
+    return argumentIndex && presentSlots.contains(argumentIndex->findSlot(argName));
 }
 
-} // namespace cli
\ No newline at end of file
+} // namespace cli
@@ -19,43 +19,86 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
-#include <unordered_set>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
 
 #ifdef CHAIN_CLI_VERBOSE
 #include <iostream>
 #endif
 
-#include "logging/logger.h"
+#include "commands/arg_handle.h"
+#include "commands/argument_index.h"
+#include "commands/slot_set.h"
 #include "context_exception.h"
+#include "logging/logger.h"
 
 namespace cli
 {
 
+/// @brief Unconverted input of an argument, stored in a CliContext in place of its value if the
+/// values are converted lazily (see CliConfig::lazyConversion).
+struct LazyValue
+{
+    std::string_view input;
+    const commands::TypedArgumentBase *argument;
+
+    /// @brief Convert the input to the value type of the argument.
+    /// @return The converted value.
+    [[nodiscard]] std::any convert() const { return argument->parseToValue(input); }
+};
+
 /// @brief Represents the context of a command-line interface (CLI) invocation and as such contains
 /// the parsed values (if present for all Arguments)
+/// @details The values are stored by the slot of their argument (see commands::ArgumentIndex), the
+/// name based accessors resolve the name to the slot with a single lookup in the argument index of
+/// the command the context was built for.
+/// @note Values that were stored as LazyValue are converted (and then kept) on first access, so
+/// the accessors of such a context must not be called concurrently.
 class CliContext
 {
 public:
-    /// @brief Constructs a new CliContext object from the passed argument maps.
-    /// @param posArgs a map of positional argument names to their values
-    /// @param optArgs a map of optional argument names to their values
-    /// @param flagArgs a set of flag argument names
+    /// @brief Constructs a new CliContext object from the parsed values of a command.
+    /// @param argumentIndex the argument index of the command the values were parsed for (may be
+    /// nullptr if the context contains no values)
+    /// @param values the parsed values, indexed by the slot of their argument
+    /// @param presentSlots the slots of the arguments that were passed
+    /// @param logger a logger instance to use in the methods this object is passed to
+    explicit CliContext(const commands::ArgumentIndex *argumentIndex,
+                        std::pmr::vector<std::any> values, commands::SlotSet presentSlots,
+                        cli::logging::AbstractLogger &logger)
+        : logger(logger), argumentIndex(argumentIndex), values(std::move(values)),
+          presentSlots(std::move(presentSlots))
+    {
+    }
+
+    /// @brief Constructs a new CliContext object that owns the argument index of its values.
+    /// @details Used for contexts built without a command, whose index only holds the names the
+    /// values were added with.
+    /// @param argumentIndex the argument index the values were added with
+    /// @param values the added values, indexed by their slot
+    /// @param presentSlots the slots of the arguments that were added
     /// @param logger a logger instance to use in the methods this object is passed to
-    explicit CliContext(std::unique_ptr<std::unordered_map<std::string, std::any>> posArgs,
-                        std::unique_ptr<std::unordered_map<std::string, std::any>> optArgs,
-                        std::unique_ptr<std::unordered_set<std::string>> flagArgs,
+    explicit CliContext(std::shared_ptr<const commands::ArgumentIndex> argumentIndex,
+                        std::pmr::vector<std::any> values, commands::SlotSet presentSlots,
                         cli::logging::AbstractLogger &logger)
-        : logger(logger), positionalArgs(std::move(posArgs)), optionArgs(std::move(optArgs)),
-          flagArgs(std::move(flagArgs))
+        : CliContext(argumentIndex.get(), std::move(values), std::move(presentSlots), logger)
     {
+        ownedIndex = std::move(argumentIndex);
     }
 
     // Non-copyable
     CliContext(const CliContext &) = delete;
     CliContext &operator=(const CliContext &) = delete;
 
+    // Move constructible (the logger reference can not be reseated)
+    CliContext(CliContext &&) noexcept = default;
+    CliContext &operator=(CliContext &&) = delete;
+
     /// @brief Checks if an argument with the given name is present in the context.
     /// @param argName the name of the argument to check
     /// @return true if the argument is present, false otherwise
@@ -76,6 +119,52 @@ public:
     /// @return true if the argument is present, false otherwise
     bool isFlagPresent(const std::string &argName) const;
 
+    /// @brief Gets the value of a positional or option argument through its handle
+    /// @details The value is loaded directly from the slot of the argument, no name lookup is done.
+    /// @note For repeatable arguments use getRepeatable.
+    /// @tparam T the value type of the argument
+    /// @param handle the handle obtained when adding the argument to the command
+    /// @return a reference to the value of the argument, valid as long as this context
+    template <typename T> const T &get(const commands::ArgHandle<T> &handle) const
+    {
+        size_t slot = handle.getSlot();
+        if (presentSlots.contains(slot))
+        {
+            if (const auto *typed = std::any_cast<T>(&resolve(values[slot])))
+            {
+                return *typed;
+            }
+        }
+        throwInvalidAccess(slot, typeid(T));
+    }
+
+    /// @brief Checks if a flag was passed through its handle
+    /// @param handle the handle obtained when adding the flag to the command
+    /// @return true if the flag is present, false otherwise
+    bool get(const commands::FlagHandle &handle) const noexcept
+    {
+        return presentSlots.contains(handle.getSlot());
+    }
+
+    /// @brief Gets all values of a repeatable positional or option argument through its handle
+    /// @tparam T the value type of the argument
+    /// @param handle the handle obtained when adding the argument to the command
+    /// @return a vector of all values of the repeatable argument
+    template <typename T>
+    std::vector<T> getRepeatable(const commands::ArgHandle<T> &handle) const
+    {
+        return getRepeatableValues<T>(slotName(handle.getSlot()), handle.getSlot());
+    }
+
+    /// @brief Checks if the argument referenced by a handle is present in the context.
+    /// @tparam T the value type of the argument
+    /// @param handle the handle obtained when adding the argument to the command
+    /// @return true if the argument is present, false otherwise
+    template <typename T> bool isPresent(const commands::ArgHandle<T> &handle) const noexcept
+    {
+        return presentSlots.contains(handle.getSlot());
+    }
+
     /// @brief Gets the value of a positional argument
     /// @tparam T the type to cast the argument value to (should be the same as the one used in
     /// defining the Argument)
@@ -86,7 +175,7 @@ public:
 #ifdef CHAIN_CLI_VERBOSE
         std::cout << "Getting positional argument '" << argName << "' as type " << typeid(T).name() << "\n";
 #endif
-        return getAnyCast<T>(argName, *positionalArgs);
+        return getValue<T>(argName, slotOf(argName, commands::ArgumentKind::Positional));
     }
 
     /// @brief Gets the value of a positional argument and stores it in the provided output variable
@@ -96,7 +185,7 @@ public:
     /// @param out the output variable to store the argument value in
     template <typename T> void getPositionalArg(const std::string &argName, T &out) const
     {
-        out = getAnyCast<T>(argName, *positionalArgs);
+        out = getValue<T>(argName, slotOf(argName, commands::ArgumentKind::Positional));
     }
 
     /// @brief Gets the value of an optional argument
@@ -109,7 +198,7 @@ public:
 #ifdef CHAIN_CLI_VERBOSE
         std::cout << "Getting option argument '" << argName << "' as type " << typeid(T).name() << "\n";
 #endif
-        return getAnyCast<T>(argName, *optionArgs);
+        return getValue<T>(argName, slotOf(argName, commands::ArgumentKind::Option));
     }
 
     /// @brief Gets the value of an optional argument and stores it in the provided output variable
@@ -119,7 +208,7 @@ public:
     /// @param out the output variable to store the argument value in
     template <typename T> void getOptionArg(const std::string &argName, T &out) const
     {
-        out = getAnyCast<T>(argName, *optionArgs);
+        out = getValue<T>(argName, slotOf(argName, commands::ArgumentKind::Option));
     }
 
     /// @brief Gets all values of a repeatable option argument
@@ -132,26 +221,7 @@ public:
 #ifdef CHAIN_CLI_VERBOSE
         std::cout << "Getting repeatable option argument '" << argName << "' as vector of type " << typeid(T).name() << "\n";
 #endif
-        auto it = optionArgs->find(argName);
-        if (it == optionArgs->end())
-            throw MissingArgumentException(argName, *optionArgs);
-
-        try
-        {
-            auto anyVec = getAnyCast<std::vector<std::any>>(argName, *optionArgs);
-            std::vector<T> result;
-            result.reserve(anyVec.size());
-            for (const auto &elem : anyVec)
-            {
-                result.push_back(std::any_cast<T>(elem));
-            }
-
-            return result;
-        }
-        catch (const std::bad_any_cast &)
-        {
-            throw InvalidArgumentTypeException(argName, typeid(std::vector<T>), it->second.type());
-        }
+        return getRepeatableValues<T>(argName, slotOf(argName, commands::ArgumentKind::Option));
     }
 
     /// @brief Gets all values of a repeatable positional argument
@@ -166,26 +236,8 @@ public:
 #ifdef CHAIN_CLI_VERBOSE
         std::cout << "Getting repeatable positional argument '" << argName << "' as vector of type " << typeid(T).name() << "\n";
 #endif
-        auto it = positionalArgs->find(argName);
-        if (it == positionalArgs->end())
-            throw MissingArgumentException(argName, *positionalArgs);
-
-        try
-        {
-            auto anyVec = getAnyCast<std::vector<std::any>>(argName, *positionalArgs);
-            std::vector<T> result;
-            result.reserve(anyVec.size());
-            for (const auto &elem : anyVec)
-            {
-                result.push_back(std::any_cast<T>(elem));
-            }
-
-            return result;
-        }
-        catch (const std::bad_any_cast &)
-        {
-            throw InvalidArgumentTypeException(argName, typeid(std::vector<T>), it->second.type());
-        }
+        return getRepeatableValues<T>(argName,
+                                      slotOf(argName, commands::ArgumentKind::Positional));
     }
 
     /// @brief Gets the value of an argument
@@ -198,18 +250,7 @@ public:
 #ifdef CHAIN_CLI_VERBOSE
         std::cout << "Getting any argument '" << argName << "' as type " << typeid(T).name() << "\n";
 #endif
-        if (isPositionalArgPresent(argName))
-        {
-            return getAnyCast<T>(argName, *positionalArgs);
-        }
-        else if (isOptionArgPresent(argName))
-        {
-            return getAnyCast<T>(argName, *optionArgs);
-        }
-        else
-        {
-            throw MissingArgumentException(argName, *positionalArgs);
-        }
+        return getValue<T>(argName, valueSlotOf(argName));
     }
 
     /// @brief Gets all values of a repeatable argument
@@ -222,18 +263,7 @@ public:
 #ifdef CHAIN_CLI_VERBOSE
         std::cout << "Getting repeatable argument '" << argName << "' as vector of type " << typeid(T).name() << "\n";
 #endif
-        if (isPositionalArgPresent(argName))
-        {
-            return getRepeatablePositionalArg<T>(argName);
-        }
-        else if (isOptionArgPresent(argName))
-        {
-            return getRepeatableOptionArg<T>(argName);
-        }
-        else
-        {
-            throw MissingArgumentException(argName, *positionalArgs);
-        }
+        return getRepeatableValues<T>(argName, valueSlotOf(argName));
     }
 
     logging::AbstractLogger &Logger() const
@@ -243,27 +273,81 @@ public:
 
 private:
     cli::logging::AbstractLogger &logger;
-    std::unique_ptr<std::unordered_map<std::string, std::any>> positionalArgs;
-    std::unique_ptr<std::unordered_map<std::string, std::any>> optionArgs;
-    std::unique_ptr<std::unordered_set<std::string>> flagArgs;
+    const commands::ArgumentIndex *argumentIndex;
+    // keeps the index of a context built without a command alive
+    std::shared_ptr<const commands::ArgumentIndex> ownedIndex;
+    // mutable as lazily converted values are replaced by their conversion result on first access
+    mutable std::pmr::vector<std::any> values;
+    commands::SlotSet presentSlots;
+
+    // slot of the argument with the given name and kind, npos if there is none
+    size_t slotOf(std::string_view name, commands::ArgumentKind kind) const;
+
+    // slot of the positional or option argument with the given name, npos if there is none
+    size_t valueSlotOf(std::string_view name) const;
+
+    std::vector<std::string_view> presentArgumentNames() const;
+
+    // name of the argument in the given slot, used for error messages
+    std::string_view slotName(size_t slot) const;
+
+    // throws the exception matching a failed access through a handle
+    [[noreturn]] void throwInvalidAccess(size_t slot, const std::type_info &requested) const;
+
+    // converts a lazily stored value in place
+    static const std::any &resolve(std::any &value)
+    {
+        if (const auto *lazy = std::any_cast<LazyValue>(&value))
+        {
+            value = lazy->convert();
+        }
+        return value;
+    }
+
+    const std::any &valueAt(std::string_view name, size_t slot) const
+    {
+        if (!presentSlots.contains(slot))
+        {
+            throw MissingArgumentException(name, presentArgumentNames());
+        }
+        return resolve(values[slot]);
+    }
+
+    template <typename T> T getValue(std::string_view name, size_t slot) const
+    {
+        const std::any &value = valueAt(name, slot);
+        if (const auto *typed = std::any_cast<std::remove_cvref_t<T>>(&value))
+        {
+            return *typed;
+        }
+        throw InvalidArgumentTypeException(std::string(name), typeid(T), value.type());
+    }
 
     template <typename T>
-    static T getAnyCast(const std::string &name, std::unordered_map<std::string, std::any> &dict)
+    std::vector<T> getRepeatableValues(std::string_view name, size_t slot) const
     {
-        try
+        const std::any &value = valueAt(name, slot);
+        auto *anyVec = std::any_cast<std::pmr::vector<std::any>>(&values[slot]);
+        if (!anyVec)
         {
-            auto it = dict.find(name);
-            if (it == dict.end())
-            {
-                throw MissingArgumentException(name, dict);
-            }
-            return std::any_cast<T>(it->second);
+            throw InvalidArgumentTypeException(std::string(name), typeid(std::vector<T>),
+                                               value.type());
         }
-        catch (const std::bad_any_cast &)
+
+        std::vector<T> result;
+        result.reserve(anyVec->size());
+        for (auto &elem : *anyVec)
         {
-            throw InvalidArgumentTypeException(name, typeid(T), dict.at(name).type());
+            const auto *typed = std::any_cast<T>(&resolve(elem));
+            if (!typed)
+            {
+                throw InvalidArgumentTypeException(std::string(name), typeid(std::vector<T>),
+                                                   value.type());
+            }
+            result.push_back(*typed);
         }
+        return result;
     }
 };
 
-} // namespace cli
\ No newline at end of file
+} // namespace cli
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+
+namespace cli::commands
+{
+class Command;
+
+/// @brief Typed reference to a positional or option argument of a command.
+/// @details Handles are filled in when the argument is added to a command (see e.g.
+/// Command::withOptionArgument) and can then be passed to CliContext::get to retrieve the parsed
+/// value with a direct indexed load instead of a name lookup. The value type is part of the
+/// handle, so requesting a value of the wrong type does not compile.
+/// @note A handle is only valid for contexts of the command it was obtained from.
+/// @tparam T The value type of the argument.
+template <typename T> class ArgHandle
+{
+    friend class Command;
+
+public:
+    /// @brief The value type of the referenced argument.
+    using value_type = T;
+
+    /// @brief Construct a handle that does not reference any argument yet.
+    constexpr ArgHandle() = default;
+
+    /// @brief Get the slot of the referenced argument.
+    /// @return The slot of the argument in the contexts of its command.
+    [[nodiscard]] constexpr size_t getSlot() const noexcept { return slot; }
+
+    /// @brief Check if the handle references an argument.
+    /// @return True if the handle was filled in by a command, false otherwise.
+    [[nodiscard]] constexpr bool isValid() const noexcept { return slot != invalidSlot; }
+
+private:
+    static constexpr size_t invalidSlot = static_cast<size_t>(-1);
+
+    constexpr explicit ArgHandle(size_t slot) : slot(slot) {}
+
+    size_t slot{invalidSlot};
+};
+
+/// @brief Reference to a flag argument of a command.
+/// @details See ArgHandle, CliContext::get returns whether the flag was passed.
+class FlagHandle
+{
+    friend class Command;
+
+public:
+    /// @brief Construct a handle that does not reference any flag yet.
+    constexpr FlagHandle() = default;
+
+    /// @brief Get the slot of the referenced flag.
+    /// @return The slot of the flag in the contexts of its command.
+    [[nodiscard]] constexpr size_t getSlot() const noexcept { return slot; }
+
+    /// @brief Check if the handle references a flag.
+    /// @return True if the handle was filled in by a command, false otherwise.
+    [[nodiscard]] constexpr bool isValid() const noexcept { return slot != invalidSlot; }
+
+private:
+    static constexpr size_t invalidSlot = static_cast<size_t>(-1);
+
+    constexpr explicit FlagHandle(size_t slot) : slot(slot) {}
+
+    size_t slot{invalidSlot};
+};
+
+} // namespace cli::commands
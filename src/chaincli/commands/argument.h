@@ -116,7 +116,7 @@ public:
     /// @brief Parse the input string to the argument's value type.
     /// @param input The input string to parse.
     /// @return The parsed value as std::any.
-    [[nodiscard]] virtual std::any parseToValue(const std::string &input) const = 0;
+    [[nodiscard]] virtual std::any parseToValue(std::string_view input) const = 0;
 
 protected:
     explicit TypedArgumentBase(std::type_index t) : type(t) {}
@@ -0,0 +1,225 @@
+// Copyright 2025 Dominik Czekai
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "argument_index.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "argument_group.h"
+#include "command.h"
+
+#define inline_t
+
+namespace cli::commands
+{
+inline_t void ArgumentIndex::build(const Command &command)
+{
+    arguments = command.getAllArguments();
+    byName.clear();
+    byName.reserve(2 * arguments.size());
+    positionalSlots.clear();
+    suggestions.clear();
+    sortedNames.clear();
+    unboundNames.clear();
+
+    // the insertion order decides which argument wins a name that is used more than once
+    addNames(ArgumentKind::Option);
+    addNames(ArgumentKind::Flag);
+    addNames(ArgumentKind::Positional);
+    buildMasks(command);
+    built = true;
+}
+
+inline_t void ArgumentIndex::clear() noexcept
+{
+    byName.clear();
+    arguments.clear();
+    positionalSlots.clear();
+    requiredSlots = SlotSet();
+    groupMasks.clear();
+    suggestions.clear();
+    sortedNames.clear();
+    unboundNames.clear();
+    built = false;
+}
+
+inline_t size_t ArgumentIndex::addUnboundName(std::string_view name, ArgumentKind kind)
+{
+    if (built)
+    {
+        throw std::logic_error("Can not add unbound names to an index built from a command");
+    }
+
+    // inserting may rehash the names, which invalidates the sorted entries
+    sortedNames.clear();
+    const size_t slot = arguments.size();
+    arguments.push_back(nullptr);
+    const std::string &stored = unboundNames.emplace_back(name);
+    byName.try_emplace(stored, Entry{nullptr, kind, slot});
+    if (kind == ArgumentKind::Positional)
+    {
+        positionalSlots.push_back(slot);
+    }
+    requiredSlots.resize(arguments.size());
+    return slot;
+}
+
+inline_t std::vector<std::string_view> ArgumentIndex::suggest(std::string_view name,
+                                                              size_t limit) const
+{
+    if (suggestions.size() == 0)
+    {
+        for (const auto &[indexedName, entry] : byName)
+        {
+            if (entry.kind != ArgumentKind::Positional)
+            {
+                suggestions.insert(indexedName);
+            }
+        }
+    }
+
+    std::vector<std::string_view> names;
+    for (const auto &suggestion : suggestions.closest(name, limit))
+    {
+        names.push_back(suggestion.name);
+    }
+    return names;
+}
+
+inline_t std::span<const ArgumentIndex::NamedEntry> ArgumentIndex::namesWithPrefix(
+    std::string_view prefix) const
+{
+    if (sortedNames.empty())
+    {
+        for (const auto &[indexedName, entry] : byName)
+        {
+            if (entry.kind != ArgumentKind::Positional)
+            {
+                sortedNames.push_back(NamedEntry{indexedName, &entry});
+            }
+        }
+        std::ranges::sort(sortedNames, {}, &NamedEntry::name);
+    }
+
+    // the names starting with the prefix are the ones whose first prefix.size() characters equal
+    // it, which is a contiguous range of the sorted names
+    const auto first = std::ranges::lower_bound(sortedNames, prefix, {}, &NamedEntry::name);
+    const auto last = std::upper_bound(
+        first, sortedNames.end(), prefix, [](std::string_view value, const NamedEntry &named) {
+            return value < named.name.substr(0, value.size());
+        });
+    return {first, last};
+}
+
+inline_t void ArgumentIndex::buildMasks(const Command &command)
+{
+    // groups hold the arguments themselves, so their slots are looked up by identity
+    std::unordered_map<const ArgumentBase *, size_t> slotOf;
+    slotOf.reserve(arguments.size());
+    for (size_t slot = 0; slot < arguments.size(); ++slot)
+    {
+        slotOf.try_emplace(arguments[slot], slot);
+    }
+
+    requiredSlots = SlotSet(arguments.size());
+    groupMasks.clear();
+    for (const auto &group : command.getArgumentGroups())
+    {
+        SlotSet members(arguments.size());
+        for (const auto &argument : group->getArguments())
+        {
+            auto it = slotOf.find(argument.get());
+            if (it == slotOf.end())
+                continue;
+
+            members.insert(it->second);
+            if (argument->isRequired())
+            {
+                requiredSlots.insert(it->second);
+            }
+        }
+
+        if (group->isExclusive() || group->isInclusive())
+        {
+            groupMasks.push_back(GroupMask{group.get(), std::move(members)});
+        }
+    }
+}
+
+inline_t void ArgumentIndex::addNames(ArgumentKind kind)
+{
+    for (size_t slot = 0; slot < arguments.size(); ++slot)
+    {
+        const ArgumentBase *argument = arguments[slot];
+        if (argument->getArgType() != kind)
+            continue;
+
+        addName(argument->getName(), argument, kind, slot);
+        switch (kind)
+        {
+        case ArgumentKind::Option:
+            addName(static_cast<const OptionArgumentBase *>(argument)->getShortName(), argument,
+                    kind, slot);
+            break;
+        case ArgumentKind::Flag:
+            addName(static_cast<const FlagArgument *>(argument)->getShortName(), argument, kind,
+                    slot);
+            break;
+        case ArgumentKind::Positional:
+            positionalSlots.push_back(slot);
+            break;
+        }
+    }
+}
+
+inline_t void ArgumentIndex::addName(std::string_view name, const ArgumentBase *argument,
+                                     ArgumentKind kind, size_t slot)
+{
+    // an empty short name means the argument has none
+    if (!name.empty())
+    {
+        byName.try_emplace(name, Entry{argument, kind, slot});
+    }
+}
+
+inline_t const ArgumentIndex::Entry *ArgumentIndex::find(std::string_view name) const
+{
+    auto it = byName.find(name);
+    return it != byName.end() ? &it->second : nullptr;
+}
+
+inline_t size_t ArgumentIndex::findSlot(std::string_view name) const
+{
+    const Entry *entry = find(name);
+    return entry ? entry->slot : npos;
+}
+
+inline_t const OptionArgumentBase *ArgumentIndex::findOption(std::string_view name) const
+{
+    const Entry *entry = find(name);
+    if (!entry || entry->kind != ArgumentKind::Option)
+        return nullptr;
+    return static_cast<const OptionArgumentBase *>(entry->argument);
+}
+
+inline_t const FlagArgument *ArgumentIndex::findFlag(std::string_view name) const
+{
+    const Entry *entry = find(name);
+    if (!entry || entry->kind != ArgumentKind::Flag)
+        return nullptr;
+    return static_cast<const FlagArgument *>(entry->argument);
+}
+} // namespace cli::commands
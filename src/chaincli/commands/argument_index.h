@@ -0,0 +1,192 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <deque>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "argument.h"
+#include "slot_set.h"
+#include "suggestion_index.h"
+
+namespace cli::commands
+{
+class ArgumentGroup;
+class Command;
+class OptionArgumentBase;
+class FlagArgument;
+
+/// @brief Lookup table from the names of the arguments of a command to the arguments themselves
+/// and their slots.
+/// @details The index is built once per command (usually when the CliApp is initialized) so that
+/// classifying an input token costs a single hash lookup, independent of how many arguments the
+/// command has. Every argument is also assigned a dense slot (its position in
+/// Command::getAllArguments()), which is used to store its parsed value in a CliContext.
+/// @note The stored names are views into the arguments of the command the index was built from,
+/// it has to be rebuilt if arguments are added to that command afterwards.
+class ArgumentIndex
+{
+public:
+    /// @brief Value returned by the slot lookups if no argument matches.
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /// @brief An indexed argument together with its kind and slot.
+    struct Entry
+    {
+        const ArgumentBase *argument;
+        ArgumentKind kind;
+        size_t slot;
+    };
+
+    /// @brief An option or flag name together with the entry of its argument.
+    struct NamedEntry
+    {
+        std::string_view name;
+        const Entry *entry;
+    };
+
+    /// @brief The slots of the members of an exclusive or inclusive argument group.
+    struct GroupMask
+    {
+        const ArgumentGroup *group;
+        SlotSet members;
+    };
+
+    /// @brief Build the index for the given command, replacing any previous content.
+    /// @details Long and short names of options and flags as well as the names of positional
+    /// arguments are indexed. If two arguments share a name, the argument that was added first is
+    /// kept, options take precedence over flags and flags over positional arguments.
+    /// @param command The command whose arguments should be indexed.
+    void build(const Command &command);
+
+    /// @brief Add a name that does not belong to an argument of a command, with a new slot.
+    /// @details Used by ContextBuilder instances that are not bound to a command, so values can
+    /// still be added and read by name. The name is copied, no argument is stored for the slot.
+    /// @param name The name to add.
+    /// @param kind The kind of argument the name stands for.
+    /// @return The new slot of the name.
+    /// @throws std::logic_error if the index was built from a command.
+    size_t addUnboundName(std::string_view name, ArgumentKind kind);
+
+    /// @brief Remove all entries and mark the index as not built.
+    void clear() noexcept;
+
+    /// @brief Check if the index was built.
+    /// @return True if the index was built and not cleared since, false otherwise.
+    [[nodiscard]] bool isBuilt() const noexcept { return built; }
+
+    /// @brief Find the option argument with the given long or short name.
+    /// @param name The name to look up.
+    /// @return A pointer to the option argument if found, nullptr otherwise.
+    [[nodiscard]] const OptionArgumentBase *findOption(std::string_view name) const;
+
+    /// @brief Find the flag argument with the given long or short name.
+    /// @param name The name to look up.
+    /// @return A pointer to the flag argument if found, nullptr otherwise.
+    [[nodiscard]] const FlagArgument *findFlag(std::string_view name) const;
+
+    /// @brief Find the argument with the given name (or short name for options and flags).
+    /// @param name The name to look up.
+    /// @return A pointer to the entry of the argument if found, nullptr otherwise.
+    [[nodiscard]] const Entry *find(std::string_view name) const;
+
+    /// @brief Find the slot of the argument with the given name (or short name for options and
+    /// flags).
+    /// @param name The name to look up.
+    /// @return The slot of the argument if found, npos otherwise.
+    [[nodiscard]] size_t findSlot(std::string_view name) const;
+
+    /// @brief Find the option and flag names closest to a mistyped one.
+    /// @details The edit distance index over the names is only built on the first call, since it
+    /// is only needed to report an error.
+    /// @param name The mistyped name.
+    /// @param limit The maximum number of suggestions.
+    /// @return The closest names, the closest first.
+    [[nodiscard]] std::vector<std::string_view> suggest(std::string_view name, size_t limit) const;
+
+    /// @brief Find the option and flag names that start with a prefix.
+    /// @details The names are only sorted into an array on the first call, every call afterwards
+    /// costs two binary searches.
+    /// @param prefix The prefix the names have to start with, empty for all names.
+    /// @return The matching names sorted by name.
+    [[nodiscard]] std::span<const NamedEntry> namesWithPrefix(std::string_view prefix) const;
+
+    /// @brief Get the number of slots, which is the number of arguments of the indexed command.
+    /// @return The number of slots.
+    [[nodiscard]] size_t slotCount() const noexcept { return arguments.size(); }
+
+    /// @brief Get the argument stored in the given slot.
+    /// @param slot The slot of the argument, has to be smaller than slotCount() and must not be
+    /// added with addUnboundName().
+    /// @return The argument stored in the slot.
+    [[nodiscard]] const ArgumentBase &argumentAt(size_t slot) const { return *arguments[slot]; }
+
+    /// @brief Get the name of the argument stored in the given slot.
+    /// @param slot The slot of the argument, has to be smaller than slotCount().
+    /// @return The name of the argument, or the name added with addUnboundName().
+    [[nodiscard]] std::string_view slotName(size_t slot) const
+    {
+        return arguments[slot] ? std::string_view(arguments[slot]->getName())
+                               : std::string_view(unboundNames[slot]);
+    }
+
+    /// @brief Get the slot of the positional argument at the given position.
+    /// @param position The position of the positional argument on the command line.
+    /// @return The slot of the positional argument.
+    [[nodiscard]] size_t positionalSlot(size_t position) const
+    {
+        return positionalSlots.at(position);
+    }
+
+    /// @brief Get the slots of all required arguments of the indexed command.
+    /// @return The set of required slots.
+    [[nodiscard]] const SlotSet &getRequiredSlots() const noexcept { return requiredSlots; }
+
+    /// @brief Get the member slots of every exclusive or inclusive group of the indexed command.
+    /// @details The masks are in the order of Command::getArgumentGroups(), groups that are
+    /// neither exclusive nor inclusive are skipped.
+    /// @return The group masks.
+    [[nodiscard]] const std::vector<GroupMask> &getGroupMasks() const noexcept
+    {
+        return groupMasks;
+    }
+
+private:
+    void buildMasks(const Command &command);
+    void addNames(ArgumentKind kind);
+    void addName(std::string_view name, const ArgumentBase *argument, ArgumentKind kind,
+                 size_t slot);
+
+    std::unordered_map<std::string_view, Entry> byName;
+    std::vector<const ArgumentBase *> arguments;
+    std::vector<size_t> positionalSlots;
+    // built by suggest, positional names are not part of it since they are never typed
+    mutable SuggestionIndex suggestions;
+    // built by namesWithPrefix, the option and flag names sorted by name
+    mutable std::vector<NamedEntry> sortedNames;
+    SlotSet requiredSlots;
+    std::vector<GroupMask> groupMasks;
+    // names added with addUnboundName by slot, a deque so the indexed views stay valid
+    std::deque<std::string> unboundNames;
+    bool built{false};
+};
+
+} // namespace cli::commands
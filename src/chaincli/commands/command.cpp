@@ -28,6 +28,14 @@ namespace cli::commands
 
 inline_t std::string_view Command::getDocStringShort() const
 {
+    if (!renderedDocStringShort.empty())
+    {
+        return renderedDocStringShort;
+    }
+    if (docStringShort.empty() && docWriter)
+    {
+        docStringShort = docWriter->generateShortDocString(*this, docPath);
+    }
     if (docStringShort.empty())
     {
         throw docwriting::DocsNotBuildException(
@@ -38,6 +46,14 @@ inline_t std::string_view Command::getDocStringShort() const
 
 inline_t std::string_view Command::getDocStringLong() const
 {
+    if (!renderedDocStringLong.empty())
+    {
+        return renderedDocStringLong;
+    }
+    if (docStringLong.empty() && docWriter)
+    {
+        docStringLong = docWriter->generateLongDocString(*this, docPath);
+    }
     if (docStringLong.empty())
     {
         throw docwriting::DocsNotBuildException(
@@ -59,6 +75,27 @@ inline_t void Command::execute(const CliContext &context) const
     }
 }
 
+inline_t void Command::executeWithOwnParser(std::span<const std::string_view> /*inputs*/,
+                                            logging::AbstractLogger & /*logger*/,
+                                            size_t /*suggestionLimit*/) const
+{
+    throw MalformedCommandException(*this, "Command has no own parser");
+}
+
+inline_t void Command::buildArgumentIndex()
+{
+    argumentIndex.build(*this);
+}
+
+inline_t const ArgumentIndex &Command::getArgumentIndex() const
+{
+    if (!argumentIndex.isBuilt())
+    {
+        argumentIndex.build(*this);
+    }
+    return argumentIndex;
+}
+
 inline_t Command &Command::withShortDescription(std::string_view desc)
 {
     shortDescription = desc;
@@ -75,6 +112,8 @@ inline_t Command &Command::withFlagArgument(std::shared_ptr<FlagArgument> arg)
 {
     safeAddToArgGroup(arg);
     flagArguments.push_back(arg);
+    allArguments.push_back(arg.get());
+    argumentIndex.clear();
     return *this;
 }
 
@@ -88,6 +127,22 @@ inline_t Command &Command::withFlagArgument(FlagArgument &arg)
     return withFlagArgument(std::make_shared<FlagArgument>(arg));
 }
 
+inline_t Command &Command::withFlagArgument(std::shared_ptr<FlagArgument> arg, FlagHandle &handle)
+{
+    handle = FlagHandle(allArguments.size());
+    return withFlagArgument(std::move(arg));
+}
+
+inline_t Command &Command::withFlagArgument(FlagArgument &&arg, FlagHandle &handle)
+{
+    return withFlagArgument(std::make_shared<FlagArgument>(std::move(arg)), handle);
+}
+
+inline_t Command &Command::withFlagArgument(FlagArgument &arg, FlagHandle &handle)
+{
+    return withFlagArgument(std::make_shared<FlagArgument>(arg), handle);
+}
+
 inline_t Command &Command::withExecutionFunc(
     std::unique_ptr<std::function<void(const CliContext &)>> actionPtr)
 {
@@ -123,8 +178,10 @@ inline_t void Command::safeAddToArgGroup(const std::shared_ptr<ArgumentBase> &ar
 
 inline_t void Command::addArgGroup(const ArgumentGroup &argGroup)
 {
+    argumentIndex.clear();
     for (auto &arg : argGroup.getArguments())
     {
+        allArguments.push_back(arg.get());
         switch (arg->getArgType())
         {
         case ArgumentKind::Flag:
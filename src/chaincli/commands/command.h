@@ -15,7 +15,9 @@
  */
 
 #pragma once
+#include "arg_handle.h"
 #include "argument_group.h"
+#include "argument_index.h"
 #include "cli_context.h"
 #include "flag_argument.h"
 #include "option_argument.h"
@@ -24,6 +26,7 @@
 #include <map>
 #include <memory>
 #include <ostream>
+#include <span>
 #include <string_view>
 
 namespace cli::commands
@@ -132,6 +135,15 @@ public:
         return flagArguments;
     }
 
+    /// @brief Get all arguments of the command.
+    /// @details The arguments are returned in the order they were added to the command, the
+    /// position of an argument in this list is its slot in the CliContext (see ArgumentIndex).
+    /// @return All arguments of the command.
+    [[nodiscard]] const std::vector<const ArgumentBase *> &getAllArguments() const noexcept
+    {
+        return allArguments;
+    }
+
     /// @brief Get the argument groups for the command.
     /// @note Argument groups appear on the command line help messages in the order they were added
     /// @return The argument groups for the command.
@@ -144,17 +156,25 @@ public:
     /// @brief Get the short documentation string for the command.
     /// @details This description only contains the textual representation of the command and its
     /// arguments as well as the short description.
-    /// @note the doc strings are cached internally and need to be built before being accessed
+    /// @note the doc strings are cached internally, they are generated on first access if the
+    /// command was bound to a DocWriter (see DocWriter::bindDocStrings) and have to be built before
+    /// being accessed otherwise
     /// @return The short documentation string for the command.
     [[nodiscard]] std::string_view getDocStringShort() const;
 
     /// @brief Get the long documentation string for the command.
     /// @details This description contains the textual representation of the command and its
     /// arguments as well as the long description and the Options segment.
-    /// @note the doc strings are cached internally and need to be built before being accessed
+    /// @note the doc strings are cached internally, see getDocStringShort
     /// @return The long documentation string for the command.
     [[nodiscard]] std::string_view getDocStringLong() const;
 
+    /// @brief Get the lookup index for the arguments of the command.
+    /// @note The index is built on first access if it was not built before (e.g. by
+    /// buildArgumentIndex) or if arguments were added since it was last built.
+    /// @return The argument index of the command.
+    [[nodiscard]] const ArgumentIndex &getArgumentIndex() const;
+
     /// @brief Get a sub-command by its identifier.
     /// @param id The identifier of the sub-command.
     /// @return A pointer to the sub-command if found, nullptr otherwise.
@@ -179,6 +199,27 @@ public:
     /// @param context The CLI context to use for execution.
     void execute(const CliContext &context) const;
 
+    /// @brief Check if the command parses its inputs itself instead of through the Parser.
+    /// @details Such commands (e.g. StaticCommand) are executed through executeWithOwnParser by the
+    /// CliApp, without building a CliContext.
+    /// @return True if the command has its own parser, false otherwise.
+    [[nodiscard]] virtual bool hasOwnParser() const noexcept { return false; }
+
+    /// @brief Parse the inputs with the command's own parser and execute the command.
+    /// @param inputs The inputs passed to the command (without the command path).
+    /// @param logger The logger of the CliApp.
+    /// @param suggestionLimit The number of closest names suggested for a mistyped option, see
+    /// CliConfig::suggestionLimit.
+    /// @throws MalformedCommandException if the command has no own parser.
+    virtual void executeWithOwnParser(std::span<const std::string_view> inputs,
+                                      logging::AbstractLogger &logger,
+                                      size_t suggestionLimit) const;
+
+    /// @brief Build the lookup index for the arguments of the command.
+    /// @details Called for every command when the CliApp is initialized, so that the parser does
+    /// not need to scan all arguments of a command for each input token.
+    void buildArgumentIndex();
+
 #pragma region ChainingMethods
     /// @brief Set the short description for the command.
     /// @param desc The short description to set.
@@ -201,6 +242,8 @@ public:
     {
         safeAddToArgGroup(arg);
         positionalArguments.push_back(arg);
+        allArguments.push_back(arg.get());
+        argumentIndex.clear();
         return *this;
     }
 
@@ -226,6 +269,44 @@ public:
         return withPositionalArgument(std::make_shared<PositionalArgument<T>>(arg));
     }
 
+    /// @brief Add a positional argument to the command and obtain a typed handle to it.
+    /// @details The handle can be passed to CliContext::get to retrieve the parsed value without a
+    /// name lookup.
+    /// @tparam T The type of the positional argument.
+    /// @param arg The positional argument to set.
+    /// @param handle Set to reference the added argument.
+    /// @return A reference to this command.
+    template <typename T>
+    Command &withPositionalArgument(std::shared_ptr<PositionalArgument<T>> arg, ArgHandle<T> &handle)
+    {
+        handle = ArgHandle<T>(allArguments.size());
+        return withPositionalArgument(std::move(arg));
+    }
+
+    /// @brief Add a positional argument to the command and obtain a typed handle to it.
+    /// @details The handle can be passed to CliContext::get to retrieve the parsed value without a
+    /// name lookup.
+    /// @tparam T The type of the positional argument.
+    /// @param arg The positional argument to set.
+    /// @param handle Set to reference the added argument.
+    /// @return A reference to this command.
+    template <typename T> Command &withPositionalArgument(PositionalArgument<T> &&arg, ArgHandle<T> &handle)
+    {
+        return withPositionalArgument(std::make_shared<PositionalArgument<T>>(std::move(arg)), handle);
+    }
+
+    /// @brief Add a positional argument to the command and obtain a typed handle to it.
+    /// @details The handle can be passed to CliContext::get to retrieve the parsed value without a
+    /// name lookup.
+    /// @tparam T The type of the positional argument.
+    /// @param arg The positional argument to set.
+    /// @param handle Set to reference the added argument.
+    /// @return A reference to this command.
+    template <typename T> Command &withPositionalArgument(PositionalArgument<T> &arg, ArgHandle<T> &handle)
+    {
+        return withPositionalArgument(std::make_shared<PositionalArgument<T>>(arg), handle);
+    }
+
     /// @brief Add an option argument to the command.
     /// @note Arguments appear on the command line help messages in the order they were added to
     /// @tparam T The type of the option argument.
@@ -235,6 +316,8 @@ public:
     {
         safeAddToArgGroup(arg);
         optionArguments.push_back(arg);
+        allArguments.push_back(arg.get());
+        argumentIndex.clear();
         return *this;
     }
 
@@ -260,6 +343,44 @@ public:
         return withOptionArgument(std::make_shared<OptionArgument<T>>(arg));
     }
 
+    /// @brief Add an option argument to the command and obtain a typed handle to it.
+    /// @details The handle can be passed to CliContext::get to retrieve the parsed value without a
+    /// name lookup.
+    /// @tparam T The type of the option argument.
+    /// @param arg The option argument to set.
+    /// @param handle Set to reference the added argument.
+    /// @return A reference to this command.
+    template <typename T>
+    Command &withOptionArgument(std::shared_ptr<OptionArgument<T>> arg, ArgHandle<T> &handle)
+    {
+        handle = ArgHandle<T>(allArguments.size());
+        return withOptionArgument(std::move(arg));
+    }
+
+    /// @brief Add an option argument to the command and obtain a typed handle to it.
+    /// @details The handle can be passed to CliContext::get to retrieve the parsed value without a
+    /// name lookup.
+    /// @tparam T The type of the option argument.
+    /// @param arg The option argument to set.
+    /// @param handle Set to reference the added argument.
+    /// @return A reference to this command.
+    template <typename T> Command &withOptionArgument(OptionArgument<T> &&arg, ArgHandle<T> &handle)
+    {
+        return withOptionArgument(std::make_shared<OptionArgument<T>>(std::move(arg)), handle);
+    }
+
+    /// @brief Add an option argument to the command and obtain a typed handle to it.
+    /// @details The handle can be passed to CliContext::get to retrieve the parsed value without a
+    /// name lookup.
+    /// @tparam T The type of the option argument.
+    /// @param arg The option argument to set.
+    /// @param handle Set to reference the added argument.
+    /// @return A reference to this command.
+    template <typename T> Command &withOptionArgument(OptionArgument<T> &arg, ArgHandle<T> &handle)
+    {
+        return withOptionArgument(std::make_shared<OptionArgument<T>>(arg), handle);
+    }
+
     /// @brief Add a flag argument to the command.
     /// @note Arguments appear on the command line help messages in the order they were added to
     /// the command.
@@ -281,6 +402,30 @@ public:
     /// @return A reference to this command.
     Command &withFlagArgument(FlagArgument &arg);
 
+    /// @brief Add a flag argument to the command and obtain a handle to it.
+    /// @details The handle can be passed to CliContext::get to check if the flag was passed without
+    /// a name lookup.
+    /// @param arg The flag argument to set.
+    /// @param handle Set to reference the added flag.
+    /// @return A reference to this command.
+    Command &withFlagArgument(std::shared_ptr<FlagArgument> arg, FlagHandle &handle);
+
+    /// @brief Add a flag argument to the command and obtain a handle to it.
+    /// @details The handle can be passed to CliContext::get to check if the flag was passed without
+    /// a name lookup.
+    /// @param arg The flag argument to set.
+    /// @param handle Set to reference the added flag.
+    /// @return A reference to this command.
+    Command &withFlagArgument(FlagArgument &&arg, FlagHandle &handle);
+
+    /// @brief Add a flag argument to the command and obtain a handle to it.
+    /// @details The handle can be passed to CliContext::get to check if the flag was passed without
+    /// a name lookup.
+    /// @param arg The flag argument to set.
+    /// @param handle Set to reference the added flag.
+    /// @return A reference to this command.
+    Command &withFlagArgument(FlagArgument &arg, FlagHandle &handle);
+
     /// @brief Set the execution function for the command.
     /// @param action The function to execute when the command is called.
     /// @return A reference to this command.
@@ -333,8 +478,22 @@ private:
     std::vector<std::shared_ptr<FlagArgument>> flagArguments;
     std::vector<std::unique_ptr<ArgumentGroup>> argumentGroups;
 
-    std::string docStringShort; // cached short doc string
-    std::string docStringLong;  // cached long doc string
+    // all of the above in the order they were added, owned by the typed vectors
+    std::vector<const ArgumentBase *> allArguments;
+
+    // name and slot lookup for the arguments, (re)built lazily when stale
+    mutable ArgumentIndex argumentIndex;
+
+    // writer and path the doc strings are generated with on first access, if bound
+    const docwriting::DocWriter *docWriter{nullptr};
+    std::string docPath;
+
+    mutable std::string docStringShort; // cached short doc string
+    mutable std::string docStringLong;  // cached long doc string
+
+    // rendered doc strings owned by someone else, e.g. a schema snapshot, used if not empty
+    std::string_view renderedDocStringShort;
+    std::string_view renderedDocStringLong;
 
     std::map<std::string, std::unique_ptr<Command>, std::less<>> subCommands;
 };
@@ -365,7 +524,8 @@ inline Command &Command::withExclusiveGroup(Args &&...args)
 {
     argumentGroups.emplace_back(std::make_unique<ExclusiveGroup>(std::forward<Args>(args)...));
     addArgGroup(*argumentGroups.back());
-    indexForNewArgGroup++;
+    // arguments added afterwards go into a new plain group instead of this one
+    indexForNewArgGroup = argumentGroups.size();
     return *this;
 }
 
@@ -376,7 +536,8 @@ inline Command &Command::withInclusiveGroup(Args &&...args)
 {
     argumentGroups.emplace_back(std::make_unique<InclusiveGroup>(std::forward<Args>(args)...));
     addArgGroup(*argumentGroups.back());
-    indexForNewArgGroup++;
+    // arguments added afterwards go into a new plain group instead of this one
+    indexForNewArgGroup = argumentGroups.size();
     return *this;
 }
 
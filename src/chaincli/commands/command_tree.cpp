@@ -32,7 +32,6 @@ inline_t std::string_view CommandTree::getPathForCommand(Command *cmd) const
 
 inline_t void CommandTree::buildCommandPathMap(const std::string &separator)
 {
-    std::unordered_map<Command *, std::string> map;
     if (root)
     {
         std::vector<std::string> path;
@@ -65,6 +64,49 @@ inline_t void CommandTree::buildCommandPathMapRecursive(Command *cmd, std::vecto
     path.pop_back();
 }
 
+inline_t Command *CommandTree::locate(std::span<const std::string_view> ids, size_t &consumed) const
+{
+    if (flatTree.isBuilt())
+    {
+        return flatTree.commandAt(flatTree.locate(ids, consumed));
+    }
+
+    consumed = 0;
+    Command *current = root.get();
+    for (const auto id : ids)
+    {
+        Command *next = current->getSubCommand(id);
+        if (!next)
+        {
+            break;
+        }
+        current = next;
+        ++consumed;
+    }
+    return current;
+}
+
+inline_t std::vector<std::string_view> CommandTree::suggest(const Command &parent,
+                                                           std::string_view identifier,
+                                                           size_t limit) const
+{
+    auto [it, inserted] = suggestionIndices.try_emplace(&parent);
+    if (inserted)
+    {
+        for (const auto &[id, subCommand] : parent.getSubCommands())
+        {
+            it->second.insert(id);
+        }
+    }
+
+    std::vector<std::string_view> identifiers;
+    for (const auto &suggestion : it->second.closest(identifier, limit))
+    {
+        identifiers.push_back(suggestion.name);
+    }
+    return identifiers;
+}
+
 inline_t std::string CommandNotFoundException::buildMessage(const std::string &id,
                                                    const std::vector<std::string> &chain)
 {
@@ -83,7 +125,12 @@ inline_t std::string CommandNotFoundException::buildMessage(const std::string &i
 inline_t std::vector<Command *> CommandTree::getAllCommands() const
 {
     std::vector<Command *> commands;
-    if (root)
+    if (flatTree.isBuilt())
+    {
+        commands.reserve(flatTree.size());
+        flatTree.forEach([&commands](Command *cmd) { commands.push_back(cmd); });
+    }
+    else if (root)
     {
         getAllCommandsRecursive(root.get(), commands);
     }
@@ -93,7 +140,12 @@ inline_t std::vector<Command *> CommandTree::getAllCommands() const
 inline_t std::vector<const Command *> CommandTree::getAllCommandsConst() const
 {
     std::vector<const Command *> commands;
-    if (root)
+    if (flatTree.isBuilt())
+    {
+        commands.reserve(flatTree.size());
+        flatTree.forEach([&commands](Command *cmd) { commands.push_back(cmd); });
+    }
+    else if (root)
     {
         getAllCommandsRecursive(root.get(), commands);
     }
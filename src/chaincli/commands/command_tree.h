@@ -17,11 +17,15 @@
 #pragma once
 #include <iostream>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "command.h"
+#include "flat_command_tree.h"
+#include "suggestion_index.h"
 
 namespace cli::commands
 {
@@ -75,6 +79,7 @@ public:
         }
 
         parentCommandPtr->withSubCommand(std::move(cmd));
+        invalidateIndices();
     }
 
     /// @brief Insert a command into the tree.
@@ -82,6 +87,7 @@ public:
     void insert(std::unique_ptr<Command> cmd) // insert at root
     {
         root->withSubCommand(std::move(cmd));
+        invalidateIndices();
     }
 
     /// @brief Find a command in the tree by a path of identifiers leading to it.
@@ -98,7 +104,11 @@ public:
     /// @param func The function to apply.
     void forEachCommand(const std::function<void(Command *)> &func) const
     {
-        if (root)
+        if (flatTree.isBuilt())
+        {
+            flatTree.forEach([&func](Command *cmd) { func(cmd); });
+        }
+        else if (root)
         {
             forEachCommandRecursive(root.get(), func);
         }
@@ -109,7 +119,11 @@ public:
     /// @param func The function to apply.
     void forEachCommand(const std::function<void(Command &)> &func) const
     {
-        if (root)
+        if (flatTree.isBuilt())
+        {
+            flatTree.forEach([&func](Command *cmd) { func(*cmd); });
+        }
+        else if (root)
         {
             forEachCommandRecursive(root.get(), func);
         }
@@ -123,6 +137,21 @@ public:
     /// @return A pointer to the root command.
     const Command *getRootCommand() const { return root.get(); }
 
+    /// @brief Build the flat representation of the tree used for dispatch and traversal.
+    /// @details Afterwards forEachCommand, getAllCommands and locating commands via the flat tree
+    /// no longer walk the nested maps of the commands. Inserting a command through the tree
+    /// discards the flat representation again, commands added directly to a Command require
+    /// calling freeze again.
+    void freeze() { flatTree.build(*root); }
+
+    /// @brief Check if the flat representation of the tree is built.
+    /// @return True if freeze was called and no command was inserted since, false otherwise.
+    [[nodiscard]] bool isFrozen() const noexcept { return flatTree.isBuilt(); }
+
+    /// @brief Get the flat representation of the tree.
+    /// @return The flat tree, empty if the tree is not frozen.
+    [[nodiscard]] const FlatCommandTree &getFlatTree() const noexcept { return flatTree; }
+
     /// @brief Get the path for a command in the tree.
     /// @note Uses a pre-built map for O(1) lookup internally that maps needs to be constructed
     /// first using the buildCommandPathMap function.
@@ -135,6 +164,29 @@ public:
     /// space).
     void buildCommandPathMap(const std::string &separator = " ");
 
+    /// @brief Check whether the command paths were built (see buildCommandPathMap).
+    /// @return True if getPathForCommand can be used.
+    [[nodiscard]] bool hasCommandPaths() const noexcept { return !commandPathMap.empty(); }
+
+    /// @brief Find the deepest command whose path is a prefix of the given identifiers.
+    /// @details Uses the edge table of the flat tree if the tree is frozen, which costs one probe
+    /// per matched identifier, otherwise the subcommand maps of the commands.
+    /// @param ids The identifiers, usually the command line arguments.
+    /// @param consumed Receives the number of identifiers that matched a subcommand.
+    /// @return The found command, the root if not even the first identifier matched.
+    Command *locate(std::span<const std::string_view> ids, size_t &consumed) const;
+
+    /// @brief Find the subcommands of a command whose identifiers are closest to a mistyped one.
+    /// @details The edit distance index over the subcommands of a command is built on the first
+    /// call for that command and kept until commands are inserted, so the cost of a lookup is
+    /// bounded even for commands with tens of thousands of subcommands.
+    /// @param parent The command whose subcommands are searched.
+    /// @param identifier The mistyped identifier.
+    /// @param limit The maximum number of suggestions.
+    /// @return The identifiers of the closest subcommands, the closest first.
+    std::vector<std::string_view> suggest(const Command &parent, std::string_view identifier,
+                                          size_t limit) const;
+
     /// @brief Get a vector of all commands in the tree.
     /// @details Commands are collected in a depth-first search (DFS) manner.
     /// @return A vector containing pointers to all commands in the tree.
@@ -147,8 +199,18 @@ public:
 
 private:
     std::unique_ptr<Command> root;
+    FlatCommandTree flatTree;
     std::unordered_map<Command *, std::string> commandPathMap;
 
+    // edit distance indices over the subcommands of a command, built when first needed
+    mutable std::unordered_map<const Command *, SuggestionIndex> suggestionIndices;
+
+    void invalidateIndices() noexcept
+    {
+        flatTree.clear();
+        suggestionIndices.clear();
+    }
+
     void buildCommandPathMapRecursive(Command *cmd, std::vector<std::string> &path,
                                       const std::string &separator);
 
@@ -0,0 +1,208 @@
+// Copyright 2025 Dominik Czekai
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "completion.h"
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+#include "commands/command.h"
+
+#define inline_t
+
+namespace cli::commands
+{
+namespace detail
+{
+// tabs and line breaks would break the line based format of the candidates
+inline_t std::string singleLine(std::string_view text)
+{
+    std::string line(text);
+    std::replace_if(
+        line.begin(), line.end(), [](char ch) { return ch == '\t' || ch == '\n' || ch == '\r'; },
+        ' ');
+    return line;
+}
+
+// name usable in shell function names
+inline_t std::string shellIdentifier(std::string_view executableName)
+{
+    // only the file name is relevant, argv[0] may contain a path
+    if (const size_t slash = executableName.find_last_of("/\\"); slash != std::string_view::npos)
+    {
+        executableName.remove_prefix(slash + 1);
+    }
+    std::string identifier(executableName);
+    std::replace_if(
+        identifier.begin(), identifier.end(),
+        [](char ch) { return std::isalnum(static_cast<unsigned char>(ch)) == 0; }, '_');
+    return identifier;
+}
+
+inline_t bool expectsValue(const Command &command, std::string_view word)
+{
+    return command.getArgumentIndex().findOption(word) != nullptr;
+}
+
+inline_t std::string optionDescription(const OptionArgumentBase &option)
+{
+    std::string description = "<" + std::string(option.getValueName()) + ">";
+    if (!option.getOptionComment().empty())
+    {
+        description += " " + singleLine(option.getOptionComment());
+    }
+    return description;
+}
+
+inline_t std::string argumentDescription(const ArgumentIndex::Entry &entry)
+{
+    if (entry.kind == ArgumentKind::Option)
+    {
+        return optionDescription(static_cast<const OptionArgumentBase &>(*entry.argument));
+    }
+    return singleLine(static_cast<const FlagArgument &>(*entry.argument).getOptionComment());
+}
+
+inline_t void completeOptions(const Command &command, std::string_view prefix, bool offerHelp,
+                              std::vector<CompletionCandidate> &candidates)
+{
+    // the sorted names are kept by the index of the command, only the matches are described
+    for (const auto &named : command.getArgumentIndex().namesWithPrefix(prefix))
+    {
+        candidates.push_back(
+            CompletionCandidate{std::string(named.name), argumentDescription(*named.entry)});
+    }
+
+    if (!offerHelp)
+    {
+        return;
+    }
+    // help is only recognized as the single argument of a command
+    for (const std::string_view help : {"--help", "-h"})
+    {
+        if (help.starts_with(prefix))
+        {
+            const auto position =
+                std::ranges::upper_bound(candidates, help, {}, &CompletionCandidate::value);
+            candidates.insert(
+                position, CompletionCandidate{std::string(help), "show the help of the command"});
+        }
+    }
+}
+
+inline_t void completeSubCommands(const Command &command, std::string_view prefix,
+                                  std::vector<CompletionCandidate> &candidates)
+{
+    // the subcommands are kept in a sorted map, so the matches are a contiguous range
+    const auto &subCommands = command.getSubCommands();
+    for (auto it = subCommands.lower_bound(prefix);
+         it != subCommands.end() && it->first.starts_with(prefix); ++it)
+    {
+        candidates.push_back(CompletionCandidate{
+            it->first, singleLine(it->second->getShortDescription())});
+    }
+}
+} // namespace detail
+
+inline_t std::vector<CompletionCandidate> Completer::complete(
+    std::span<const std::string_view> words) const
+{
+    std::vector<CompletionCandidate> candidates;
+    const std::string_view current = words.empty() ? std::string_view() : words.back();
+    const auto previous = words.empty() ? words : words.first(words.size() - 1);
+
+    size_t consumed = 0;
+    const Command &command = *tree.locate(previous, consumed);
+    const auto arguments = previous.subspan(consumed);
+
+    if (!arguments.empty() && detail::expectsValue(command, arguments.back()))
+    {
+        return candidates;
+    }
+
+    if (current.starts_with('-'))
+    {
+        detail::completeOptions(command, current, arguments.empty(), candidates);
+    }
+    else if (arguments.empty())
+    {
+        // subcommands are only recognized before the arguments of a command
+        detail::completeSubCommands(command, current, candidates);
+    }
+    return candidates;
+}
+
+inline_t void Completer::writeCandidates(std::ostream &out,
+                                         const std::vector<CompletionCandidate> &candidates)
+{
+    for (const auto &candidate : candidates)
+    {
+        out << candidate.value << '\t' << candidate.description << '\n';
+    }
+}
+
+inline_t void Completer::writeScript(std::ostream &out, std::string_view shell,
+                                     std::string_view executableName)
+{
+    const std::string function = "_" + detail::shellIdentifier(executableName) + "_complete";
+    const std::string name(executableName);
+
+    if (shell == "bash")
+    {
+        out << function << "()\n"
+            << "{\n"
+            << "    local IFS=$'\\n'\n"
+            << "    COMPREPLY=($(" << name
+            << " __complete -- \"${COMP_WORDS[@]:1:COMP_CWORD}\" 2>/dev/null | cut -f1))\n"
+            << "}\n"
+            << "complete -o default -F " << function << " " << name << "\n";
+    }
+    else if (shell == "zsh")
+    {
+        out << "#compdef " << name << "\n"
+            << function << "()\n"
+            << "{\n"
+            << "    local -a candidates\n"
+            << "    local line value\n"
+            << "    for line in \"${(@f)$(" << name
+            << " __complete -- \"${(@)words[2,CURRENT]}\" 2>/dev/null)}\"; do\n"
+            << "        [[ -z $line ]] && continue\n"
+            << "        value=${line%%$'\\t'*}\n"
+            << "        candidates+=(\"${value//:/\\\\:}:${line#*$'\\t'}\")\n"
+            << "    done\n"
+            << "    (( ${#candidates} )) && _describe 'command' candidates || _files\n"
+            << "}\n"
+            << "compdef " << function << " " << name << "\n";
+    }
+    else if (shell == "fish")
+    {
+        out << "function " << function << "\n"
+            << "    set -l candidates (" << name
+            << " __complete -- (commandline -opc)[2..-1] (commandline -ct) 2>/dev/null)\n"
+            << "    if test (count $candidates) -gt 0\n"
+            << "        printf '%s\\n' $candidates\n"
+            << "    else\n"
+            << "        __fish_complete_path (commandline -ct)\n"
+            << "    end\n"
+            << "end\n"
+            << "complete -c " << name << " -f -a '(" << function << ")'\n";
+    }
+    else
+    {
+        throw UnsupportedShellException(shell);
+    }
+}
+
+} // namespace cli::commands
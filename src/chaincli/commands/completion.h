@@ -0,0 +1,93 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "commands/command_tree.h"
+
+namespace cli::commands
+{
+/// @brief Exception thrown if a completion script is requested for an unsupported shell.
+class UnsupportedShellException : public std::runtime_error
+{
+public:
+    /// @brief Construct a new UnsupportedShellException.
+    /// @param shell The requested shell.
+    explicit UnsupportedShellException(std::string_view shell)
+        : std::runtime_error("Unsupported shell for completion: '" + std::string(shell) +
+                                "', expected bash, zsh or fish")
+    {
+    }
+};
+
+/// @brief A single completion offered to the shell.
+struct CompletionCandidate
+{
+    /// @brief The text that completes the current word.
+    std::string value;
+    /// @brief Short description shown next to the value by shells that support it.
+    std::string description;
+};
+
+/// @brief Computes shell completions from the structure of a command tree.
+/// @details The command is located like in CliApp::run, its subcommands are then found by a
+/// lower bound of the prefix in their sorted map and its options by binary searching the prefix in
+/// the sorted names kept by its ArgumentIndex (see ArgumentIndex::namesWithPrefix). Only the index
+/// of the located command is built, nothing is initialized, frozen or rendered, so the cost of a
+/// completion does not grow with the number of commands in the tree.
+class Completer
+{
+public:
+    /// @brief Create a completer for the given tree.
+    /// @param tree The command tree.
+    explicit Completer(const CommandTree &tree) : tree(tree) {}
+
+    /// @brief Compute the completions for a partial command line.
+    /// @details The leading words are matched against subcommands like in CliApp::run. If the word
+    /// before the last one is an option that expects a value, nothing is offered so the shell can
+    /// fall back to its own completion (e.g. file names).
+    /// @param words The words after the executable name, the last one is the word being completed
+    /// (empty if a new word is started).
+    /// @return The matching subcommands or options, sorted by their value.
+    [[nodiscard]] std::vector<CompletionCandidate> complete(
+        std::span<const std::string_view> words) const;
+
+    /// @brief Write the candidates in the format read by the completion scripts.
+    /// @details One candidate per line, the value and its description separated by a tab.
+    /// @param out The stream to write to.
+    /// @param candidates The candidates to write.
+    static void writeCandidates(std::ostream &out,
+                                const std::vector<CompletionCandidate> &candidates);
+
+    /// @brief Write a completion script that calls the hidden __complete entry point.
+    /// @param out The stream to write to.
+    /// @param shell The shell to write the script for, one of bash, zsh or fish.
+    /// @param executableName The name the executable is called with.
+    /// @throws UnsupportedShellException If the shell is not supported.
+    static void writeScript(std::ostream &out, std::string_view shell,
+                            std::string_view executableName);
+
+private:
+    const CommandTree &tree;
+};
+
+} // namespace cli::commands
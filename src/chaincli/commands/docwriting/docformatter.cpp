@@ -36,7 +36,7 @@ inline_t std::pair<char, char> getOptionArgumentBrackets(bool required)
 }
 
 inline_t std::string DefaultFlagFormatter::generateArgDocString(
-    const FlagArgument &argument, [[maybe_unused]] const cli::CliConfig &configuration)
+    const FlagArgument &argument, [[maybe_unused]] const cli::CliConfig &configuration) const
 {
     std::ostringstream builder;
     auto [inBracket, outBracket] = getOptionArgumentBrackets(argument.isRequired());
@@ -50,7 +50,7 @@ inline_t std::string DefaultFlagFormatter::generateArgDocString(
 }
 
 inline_t std::string DefaultFlagFormatter::generateOptionsDocString(
-    const FlagArgument &argument, [[maybe_unused]] const cli::CliConfig &configuration)
+    const FlagArgument &argument, [[maybe_unused]] const cli::CliConfig &configuration) const
 {
     std::ostringstream builder;
     builder << argument.getName();
@@ -63,7 +63,7 @@ inline_t std::string DefaultFlagFormatter::generateOptionsDocString(
 }
 
 inline_t std::string DefaultOptionFormatter::generateArgDocString(
-    const OptionArgumentBase &argument, [[maybe_unused]] const cli::CliConfig &configuration)
+    const OptionArgumentBase &argument, [[maybe_unused]] const cli::CliConfig &configuration) const
 {
     std::ostringstream builder;
     auto [inBracket, outBracket] = getOptionArgumentBrackets(argument.isRequired());
@@ -80,7 +80,7 @@ inline_t std::string DefaultOptionFormatter::generateArgDocString(
 }
 
 inline_t std::string DefaultOptionFormatter::generateOptionsDocString(
-    const OptionArgumentBase &argument, [[maybe_unused]] const cli::CliConfig &configuration)
+    const OptionArgumentBase &argument, [[maybe_unused]] const cli::CliConfig &configuration) const
 {
     std::ostringstream builder;
     builder << argument.getName();
@@ -96,7 +96,8 @@ inline_t std::string DefaultOptionFormatter::generateOptionsDocString(
 }
 
 inline_t std::string DefaultPositionalFormatter::generateArgDocString(
-    const PositionalArgumentBase &argument, [[maybe_unused]] const cli::CliConfig &configuration)
+    const PositionalArgumentBase &argument,
+    [[maybe_unused]] const cli::CliConfig &configuration) const
 {
     std::ostringstream builder;
     auto [inBracket, outBracket] = getPositionalArgumentBrackets(argument.isRequired());
@@ -110,7 +111,8 @@ inline_t std::string DefaultPositionalFormatter::generateArgDocString(
 }
 
 inline_t std::string DefaultPositionalFormatter::generateOptionsDocString(
-    const PositionalArgumentBase &argument, [[maybe_unused]] const cli::CliConfig &configuration)
+    const PositionalArgumentBase &argument,
+    [[maybe_unused]] const cli::CliConfig &configuration) const
 {
     std::ostringstream builder;
     auto [inBracket, outBracket] = getPositionalArgumentBrackets(argument.isRequired());
@@ -155,7 +157,7 @@ inline_t void addGroupArgumentDocString(std::ostringstream &builder,
 
 inline_t std::string DefaultCommandFormatter::generateLongDocString(
     const Command &command, std::string_view fullCommandPath, const DocWriter &writer,
-    [[maybe_unused]] const cli::CliConfig &configuration)
+    [[maybe_unused]] const cli::CliConfig &configuration) const
 {
     std::ostringstream builder;
     builder << fullCommandPath << " ";
@@ -180,7 +182,7 @@ inline_t std::string DefaultCommandFormatter::generateLongDocString(
 
 inline_t std::string DefaultCommandFormatter::generateShortDocString(
     const Command &command, std::string_view fullCommandPath, const DocWriter &writer,
-    [[maybe_unused]] const cli::CliConfig &configuration)
+    [[maybe_unused]] const cli::CliConfig &configuration) const
 {
     std::ostringstream builder;
     builder << fullCommandPath << " ";
@@ -196,7 +198,7 @@ inline_t std::string DefaultCommandFormatter::generateShortDocString(
 
 inline_t std::string DefaultCliAppDocFormatter::generateAppDocString(
     const cli::CliConfig &configuration,
-    const std::vector<const cli::commands::Command *> &commands)
+    const std::vector<const cli::commands::Command *> &commands) const
 {
     std::ostringstream builder;
     builder << configuration.description << "\n\n";
@@ -221,12 +223,13 @@ inline_t std::string DefaultCliAppDocFormatter::generateAppDocString(
 }
 
 inline_t std::string DefaultCliAppDocFormatter::generateCommandDocString(
-    const Command &command, [[maybe_unused]] const cli::CliConfig &configuration)
+    const Command &command, [[maybe_unused]] const cli::CliConfig &configuration) const
 {
     return std::string(command.getDocStringLong());
 }
 
-inline_t std::string DefaultCliAppDocFormatter::generateAppVersionString(const cli::CliConfig &configuration)
+inline_t std::string DefaultCliAppDocFormatter::generateAppVersionString(
+    const cli::CliConfig &configuration) const
 {
     return std::format("{} version: {}", configuration.executableName, configuration.version);
 }
@@ -28,6 +28,10 @@ namespace cli::commands::docwriting
 {
 
 /// @brief Abstract base class for argument documentation formatters.
+/// @note The generate methods may be called concurrently from several threads if the doc strings
+/// are rendered in parallel (see CliConfig::docRenderingThreads), so they are const and their
+/// output may only depend on their arguments. Implementations must not work around that with
+/// mutable members or other shared state. The default formatters are stateless.
 /// @tparam T The type of argument to format.
 template <typename T> class AbstractArgDocFormatter
 {
@@ -41,7 +45,7 @@ public:
     /// @param configuration The CLI configuration.
     /// @return The generated documentation string.
     virtual std::string generateArgDocString(const T &argument,
-                                             const cli::CliConfig &configuration) = 0;
+                                             const cli::CliConfig &configuration) const = 0;
 
     /// @brief Generate the options documentation string.
     /// @details the options doc string is used in the options section of the help message
@@ -49,7 +53,7 @@ public:
     /// @param configuration The CLI configuration.
     /// @return The generated documentation string.
     virtual std::string generateOptionsDocString(const T &argument,
-                                                 const cli::CliConfig &configuration) = 0;
+                                                 const cli::CliConfig &configuration) const = 0;
 };
 
 /// @brief Default formatter for flag arguments.
@@ -57,9 +61,9 @@ class DefaultFlagFormatter : public AbstractArgDocFormatter<FlagArgument>
 {
 public:
     std::string generateArgDocString(const FlagArgument &argument,
-                                     const cli::CliConfig &configuration) override;
+                                     const cli::CliConfig &configuration) const override;
     std::string generateOptionsDocString(const FlagArgument &argument,
-                                         const cli::CliConfig &configuration) override;
+                                         const cli::CliConfig &configuration) const override;
 };
 
 /// @brief Default formatter for option arguments.
@@ -67,9 +71,9 @@ class DefaultOptionFormatter : public AbstractArgDocFormatter<OptionArgumentBase
 {
 public:
     std::string generateArgDocString(const OptionArgumentBase &argument,
-                                     const cli::CliConfig &configuration) override;
+                                     const cli::CliConfig &configuration) const override;
     std::string generateOptionsDocString(const OptionArgumentBase &argument,
-                                         const cli::CliConfig &configuration) override;
+                                         const cli::CliConfig &configuration) const override;
 };
 
 /// @brief Default formatter for positional arguments.
@@ -77,12 +81,14 @@ class DefaultPositionalFormatter : public AbstractArgDocFormatter<PositionalArgu
 {
 public:
     std::string generateArgDocString(const PositionalArgumentBase &argument,
-                                     const cli::CliConfig &configuration) override;
+                                     const cli::CliConfig &configuration) const override;
     std::string generateOptionsDocString(const PositionalArgumentBase &argument,
-                                         const cli::CliConfig &configuration) override;
+                                         const cli::CliConfig &configuration) const override;
 };
 
 /// @brief Abstract base class for command documentation formatters.
+/// @note Like the argument formatters, implementations have to be safe to call concurrently for
+/// different commands, see AbstractArgDocFormatter.
 class AbstractCommandFormatter
 {
 public:
@@ -97,7 +103,7 @@ public:
     virtual std::string generateLongDocString(const Command &command,
                                               std::string_view fullCommandPath,
                                               const DocWriter &writer,
-                                              const cli::CliConfig &configuration) = 0;
+                                              const cli::CliConfig &configuration) const = 0;
 
     /// @brief Generate the short documentation string.
     /// @param command The command to document.
@@ -108,7 +114,7 @@ public:
     virtual std::string generateShortDocString(const Command &command,
                                                std::string_view fullCommandPath,
                                                const DocWriter &writer,
-                                               const cli::CliConfig &configuration) = 0;
+                                               const cli::CliConfig &configuration) const = 0;
 };
 
 /// @brief Default formatter for commands.
@@ -117,11 +123,11 @@ class DefaultCommandFormatter : public AbstractCommandFormatter
 public:
     std::string generateLongDocString(const Command &command, std::string_view fullCommandPath,
                                       const DocWriter &writer,
-                                      const cli::CliConfig &configuration) override;
+                                      const cli::CliConfig &configuration) const override;
 
     std::string generateShortDocString(const Command &command, std::string_view fullCommandPath,
                                        const DocWriter &writer,
-                                       const cli::CliConfig &configuration) override;
+                                       const cli::CliConfig &configuration) const override;
 };
 
 /// @brief Abstract base class for CLI application documentation formatters.
@@ -137,12 +143,12 @@ public:
     /// @return The generated documentation string.
     virtual std::string generateAppDocString(
         const cli::CliConfig &configuration,
-        const std::vector<const cli::commands::Command *> &commands) = 0;
+        const std::vector<const cli::commands::Command *> &commands) const = 0;
 
     /// @brief Generate the application version string that is shown with the --version flag.
     /// @param configuration The CLI configuration.
     /// @return The generated version string.
-    virtual std::string generateAppVersionString(const cli::CliConfig &configuration) = 0;
+    virtual std::string generateAppVersionString(const cli::CliConfig &configuration) const = 0;
 
     /// @brief Generate the documentation string for a specific command.
     /// @param command The command to document.
@@ -151,7 +157,7 @@ public:
     /// @param configuration The CLI configuration.
     /// @return The generated documentation string.
     virtual std::string generateCommandDocString(const Command &command,
-                                                 const cli::CliConfig &configuration) = 0;
+                                                 const cli::CliConfig &configuration) const = 0;
 };
 
 /// @brief Default formatter for CLI application documentation.
@@ -160,13 +166,13 @@ class DefaultCliAppDocFormatter : public AbstractCliAppDocFormatter
 public:
     std::string generateAppDocString(
         const cli::CliConfig &configuration,
-        const std::vector<const cli::commands::Command *> &commands) override;
+        const std::vector<const cli::commands::Command *> &commands) const override;
 
     std::string generateCommandDocString(
         const Command &command,
-        [[maybe_unused]] const cli::CliConfig &configuration) override;
+        [[maybe_unused]] const cli::CliConfig &configuration) const override;
 
-    std::string generateAppVersionString(const cli::CliConfig &configuration) override;
+    std::string generateAppVersionString(const cli::CliConfig &configuration) const override;
 };
 
 } // namespace cli::commands::docwriting
\ No newline at end of file
@@ -14,10 +14,16 @@
 
 #include "docwriting.h"
 #include "commands/argument.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <format>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #define inline_t
 
@@ -50,6 +56,74 @@ inline_t void DocWriter::setDocStrings(Command &command, std::string_view fullCo
 {
     command.docStringLong = generateLongDocString(command, fullCommandPath);
     command.docStringShort = generateShortDocString(command, fullCommandPath);
+    command.renderedDocStringLong = {};
+    command.renderedDocStringShort = {};
+}
+
+inline_t void DocWriter::setDocStrings(std::span<Command *const> commands,
+                                       std::span<const std::string_view> fullCommandPaths,
+                                       unsigned threadCount) const
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1U, std::thread::hardware_concurrency());
+    }
+    threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, commands.size()));
+
+    std::atomic<size_t> nextCommand{0};
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+    auto renderAll = [&]() {
+        for (size_t i = nextCommand++; i < commands.size(); i = nextCommand++)
+        {
+            try
+            {
+                setDocStrings(*commands[i], fullCommandPaths[i]);
+            }
+            catch (...)
+            {
+                std::scoped_lock lock(errorMutex);
+                if (!firstError)
+                {
+                    firstError = std::current_exception();
+                }
+            }
+        }
+    };
+
+    {
+        // the calling thread renders as well, so only threadCount - 1 threads are started
+        std::vector<std::jthread> workers;
+        for (unsigned i = 1; i < threadCount; ++i)
+        {
+            workers.emplace_back(renderAll);
+        }
+        renderAll();
+    }
+
+    if (firstError)
+    {
+        std::rethrow_exception(firstError);
+    }
+}
+
+inline_t void DocWriter::setRenderedDocStrings(Command &command, std::string_view docStringShort,
+                                               std::string_view docStringLong) const
+{
+    command.renderedDocStringShort = docStringShort;
+    command.renderedDocStringLong = docStringLong;
+    command.docStringShort.clear();
+    command.docStringLong.clear();
+}
+
+inline_t void DocWriter::bindDocStrings(Command &command, std::string_view fullCommandPath) const
+{
+    command.docWriter = this;
+    command.docPath = std::string(fullCommandPath);
+    command.docStringLong.clear();
+    command.docStringShort.clear();
+    command.renderedDocStringLong = {};
+    command.renderedDocStringShort = {};
 }
 
 inline_t std::string DocWriter::generateShortDocString(const Command &command,
@@ -16,6 +16,8 @@
 
 #pragma once
 #include <memory>
+#include <span>
+#include <string_view>
 
 #include "cli_config.h"
 #include "commands/argument.h"
@@ -64,6 +66,35 @@ public:
     /// @param fullCommandPath The full path of the command.
     void setDocStrings(Command &command, std::string_view fullCommandPath) const;
 
+    /// @brief Build and set the documentation strings for many commands, optionally in parallel.
+    /// @details The commands are distributed over the threads dynamically, every command is
+    /// rendered by exactly one thread, so the result is the same as rendering them one after
+    /// another. The formatters have to be thread-safe if more than one thread is used.
+    /// @param commands The commands to set the documentation strings for.
+    /// @param fullCommandPaths The full path of each command, in the same order as commands.
+    /// @param threadCount The number of threads to use, 0 for one per hardware thread.
+    /// @throws The first exception thrown while rendering, after all threads finished.
+    void setDocStrings(std::span<Command *const> commands,
+                       std::span<const std::string_view> fullCommandPaths,
+                       unsigned threadCount) const;
+
+    /// @brief Set already rendered documentation strings for a command, e.g. from a snapshot.
+    /// @details The strings are not copied, they have to outlive the command.
+    /// @param command The command to set the documentation strings for.
+    /// @param docStringShort The short documentation string.
+    /// @param docStringLong The long documentation string.
+    void setRenderedDocStrings(Command &command, std::string_view docStringShort,
+                               std::string_view docStringLong) const;
+
+    /// @brief Let a command build its documentation strings with this writer on first access.
+    /// @details Nothing is rendered here, the strings are generated and cached by
+    /// Command::getDocStringShort and Command::getDocStringLong when they are first needed, which
+    /// is only the case if help is printed. Previously cached strings are discarded.
+    /// @note The writer has to outlive the command.
+    /// @param command The command to bind to this writer.
+    /// @param fullCommandPath The full path of the command.
+    void bindDocStrings(Command &command, std::string_view fullCommandPath) const;
+
     /// @brief Generate the long documentation string for a command.
     /// @param command The command to generate the documentation string for.
     /// @param fullCommandPath The full path of the command.
@@ -0,0 +1,128 @@
+// Copyright 2025 Dominik Czekai
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "flat_command_tree.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+
+#include "command.h"
+
+#define inline_t
+
+namespace cli::commands
+{
+inline_t void FlatCommandTree::build(Command &root)
+{
+    clear();
+    addRecursive(root, 0);
+    buildEdges();
+    built = true;
+}
+
+inline_t void FlatCommandTree::clear() noexcept
+{
+    nodes.clear();
+    children.clear();
+    pool.clear();
+    edges.clear();
+    built = false;
+}
+
+inline_t uint32_t FlatCommandTree::addRecursive(Command &command, uint32_t parent)
+{
+    const auto index = static_cast<uint32_t>(nodes.size());
+    const std::string_view identifier = command.getIdentifier();
+    nodes.push_back(Node{&command, parent, static_cast<uint32_t>(pool.size()),
+                         static_cast<uint32_t>(identifier.size()), 0, 0});
+    pool.append(identifier);
+
+    // subcommands are kept in a std::map, so they are visited in sorted order already
+    std::vector<uint32_t> childIndices;
+    childIndices.reserve(command.getSubCommands().size());
+    for (const auto &[id, subCommand] : command.getSubCommands())
+    {
+        childIndices.push_back(addRecursive(*subCommand, index));
+    }
+
+    nodes[index].firstChild = static_cast<uint32_t>(children.size());
+    nodes[index].childCount = static_cast<uint32_t>(childIndices.size());
+    children.insert(children.end(), childIndices.begin(), childIndices.end());
+    return index;
+}
+
+inline_t void FlatCommandTree::buildEdges()
+{
+    // at most half full, so probe sequences stay short
+    edges.assign(std::bit_ceil(std::max<size_t>(2 * nodes.size(), 2)), 0);
+    const size_t mask = edges.size() - 1;
+    for (uint32_t child = 1; child < nodes.size(); ++child)
+    {
+        size_t slot = edgeSlot(nodes[child].parent, identifierAt(child));
+        while (edges[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        edges[slot] = child;
+    }
+}
+
+inline_t size_t FlatCommandTree::edgeSlot(uint32_t parent,
+                                          std::string_view identifier) const noexcept
+{
+    const size_t hash = std::hash<std::string_view>{}(identifier) ^
+                        (static_cast<size_t>(parent) * 0x9e3779b97f4a7c15ULL);
+    return hash & (edges.size() - 1);
+}
+
+inline_t size_t FlatCommandTree::findChild(size_t index, std::string_view identifier) const noexcept
+{
+    if (edges.empty())
+    {
+        return npos;
+    }
+
+    const auto parent = static_cast<uint32_t>(index);
+    const size_t mask = edges.size() - 1;
+    for (size_t slot = edgeSlot(parent, identifier); edges[slot] != 0; slot = (slot + 1) & mask)
+    {
+        const uint32_t child = edges[slot];
+        if (nodes[child].parent == parent && identifierAt(child) == identifier)
+        {
+            return child;
+        }
+    }
+    return npos;
+}
+
+inline_t size_t FlatCommandTree::locate(std::span<const std::string_view> ids,
+                                        size_t &consumed) const noexcept
+{
+    size_t current = 0;
+    consumed = 0;
+    for (const auto id : ids)
+    {
+        const size_t child = findChild(current, id);
+        if (child == npos)
+        {
+            break;
+        }
+        current = child;
+        ++consumed;
+    }
+    return current;
+}
+} // namespace cli::commands
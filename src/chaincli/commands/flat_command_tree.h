@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cli::commands
+{
+class Command;
+
+/// @brief Frozen, flat copy of the structure of a command tree.
+/// @details All commands are stored in one contiguous array in depth-first order (the order of
+/// CommandTree::forEachCommand), the children of each command as a contiguous, sorted range of
+/// indices and all identifiers in a single string pool. Every edge of the tree (a parent and the
+/// identifier of one of its children) is also hashed into one open addressing table of node
+/// indices, so following a path costs a single probe per identifier. Locating a command or
+/// visiting all commands therefore only touches a few arrays instead of chasing the pointers of
+/// the nested std::maps of the commands.
+/// @note The commands themselves are not copied, the flat tree has to be rebuilt if commands are
+/// added to or removed from the tree it was built from.
+class FlatCommandTree
+{
+public:
+    /// @brief Value returned by the lookups if no command matches.
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /// @brief Build the flat tree from the given root command, replacing any previous content.
+    /// @param root The root command of the tree, it is stored at index 0.
+    void build(Command &root);
+
+    /// @brief Remove all commands and mark the flat tree as not built.
+    void clear() noexcept;
+
+    /// @brief Check if the flat tree was built.
+    /// @return True if the flat tree was built and not cleared since, false otherwise.
+    [[nodiscard]] bool isBuilt() const noexcept { return built; }
+
+    /// @brief Get the number of commands in the flat tree.
+    /// @return The number of commands, including the root.
+    [[nodiscard]] size_t size() const noexcept { return nodes.size(); }
+
+    /// @brief Get the command stored at the given index.
+    /// @param index The index of the command, has to be smaller than size().
+    /// @return The command.
+    [[nodiscard]] Command *commandAt(size_t index) const noexcept { return nodes[index].command; }
+
+    /// @brief Get the identifier of the command stored at the given index.
+    /// @param index The index of the command, has to be smaller than size().
+    /// @return A view into the string pool of the flat tree.
+    [[nodiscard]] std::string_view identifierAt(size_t index) const noexcept
+    {
+        return std::string_view(pool).substr(nodes[index].nameOffset, nodes[index].nameLength);
+    }
+
+    /// @brief Get the indices of the direct children of a command, sorted by their identifiers.
+    /// @param index The index of the command, has to be smaller than size().
+    /// @return The indices of the children.
+    [[nodiscard]] std::span<const uint32_t> childrenOf(size_t index) const noexcept
+    {
+        return std::span<const uint32_t>(children).subspan(nodes[index].firstChild,
+                                                           nodes[index].childCount);
+    }
+
+    /// @brief Find the direct child of a command with the given identifier.
+    /// @details Costs one probe of the edge table, the identifier is only hashed once.
+    /// @param index The index of the parent command, has to be smaller than size().
+    /// @param identifier The identifier of the child.
+    /// @return The index of the child if found, npos otherwise.
+    [[nodiscard]] size_t findChild(size_t index, std::string_view identifier) const noexcept;
+
+    /// @brief Follow the given identifiers from the root as far as they match subcommands.
+    /// @details Resolves the longest matching chain in one pass over the identifiers.
+    /// @param ids The identifiers, usually the command line arguments.
+    /// @param consumed Receives the number of identifiers that matched a subcommand.
+    /// @return The index of the deepest matched command (0 for the root if none matched).
+    [[nodiscard]] size_t locate(std::span<const std::string_view> ids,
+                                size_t &consumed) const noexcept;
+
+    /// @brief Apply a function to each command in depth-first order.
+    /// @tparam Func Callable taking a Command pointer.
+    /// @param func The function to apply.
+    template <typename Func> void forEach(Func &&func) const
+    {
+        for (const auto &node : nodes)
+        {
+            func(node.command);
+        }
+    }
+
+private:
+    struct Node
+    {
+        Command *command;
+        uint32_t parent;
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t firstChild;
+        uint32_t childCount;
+    };
+
+    uint32_t addRecursive(Command &command, uint32_t parent);
+    void buildEdges();
+    [[nodiscard]] size_t edgeSlot(uint32_t parent, std::string_view identifier) const noexcept;
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> children;
+    std::string pool;
+    // open addressing table over all edges, holds child indices and 0 for empty slots (the root
+    // is never a child), its size is a power of two
+    std::vector<uint32_t> edges;
+    bool built{false};
+};
+
+} // namespace cli::commands
@@ -80,7 +80,7 @@ public:
     {
     }
 
-    [[nodiscard]] std::any parseToValue(const std::string &input) const override;
+    [[nodiscard]] std::any parseToValue(std::string_view input) const override;
 
 #pragma region ChainingMethods
 
@@ -126,7 +126,7 @@ public:
 };
 
 template <typename T>
-inline std::any OptionArgument<T>::parseToValue(const std::string &input) const
+inline std::any OptionArgument<T>::parseToValue(std::string_view input) const
 {
     return cli::parsing::ParseHelper::parse<T>(input);
 }
@@ -69,7 +69,7 @@ public:
     {
     }
 
-    [[nodiscard]] std::any parseToValue(const std::string &input) const override;
+    [[nodiscard]] std::any parseToValue(std::string_view input) const override;
 
 #pragma region ChainingMethods
 
@@ -108,7 +108,7 @@ public:
 };
 
 template <typename T>
-inline std::any PositionalArgument<T>::parseToValue(const std::string &input) const
+inline std::any PositionalArgument<T>::parseToValue(std::string_view input) const
 {
     return cli::parsing::ParseHelper::parse<T>(input);
 }
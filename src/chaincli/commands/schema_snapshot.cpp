@@ -0,0 +1,449 @@
+// Copyright 2025 Dominik Czekai
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "schema_snapshot.h"
+
+#include <algorithm>
+#include <format>
+#include <unordered_map>
+
+#include "command_tree.h"
+
+#define inline_t
+
+namespace cli::commands
+{
+namespace detail
+{
+inline constexpr std::string_view snapshotMagic = "CCLS";
+inline constexpr uint32_t snapshotVersion = 2;
+
+inline constexpr uint8_t requiredBit = 1;
+inline constexpr uint8_t repeatableBit = 2;
+inline constexpr uint8_t exclusiveBit = 1;
+inline constexpr uint8_t inclusiveBit = 2;
+
+// integers are stored little endian independent of the platform
+class SnapshotWriter
+{
+public:
+    void writeByte(uint8_t value) { blob.push_back(static_cast<char>(value)); }
+
+    void writeU32(uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            writeByte(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void writeU64(uint64_t value)
+    {
+        writeU32(static_cast<uint32_t>(value));
+        writeU32(static_cast<uint32_t>(value >> 32));
+    }
+
+    void writeString(std::string_view value)
+    {
+        writeU32(static_cast<uint32_t>(value.size()));
+        blob.append(value);
+    }
+
+    std::string blob;
+};
+
+class SnapshotReader
+{
+public:
+    explicit SnapshotReader(std::string_view blob, size_t pos = 0) : blob(blob), pos(pos) {}
+
+    uint8_t readByte()
+    {
+        require(1);
+        return static_cast<uint8_t>(blob[pos++]);
+    }
+
+    uint32_t readU32()
+    {
+        require(4);
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            value |= static_cast<uint32_t>(static_cast<uint8_t>(blob[pos++])) << (8 * i);
+        }
+        return value;
+    }
+
+    uint64_t readU64()
+    {
+        const uint64_t low = readU32();
+        return low | (static_cast<uint64_t>(readU32()) << 32);
+    }
+
+    std::string_view readString()
+    {
+        const uint32_t length = readU32();
+        require(length);
+        std::string_view value = blob.substr(pos, length);
+        pos += length;
+        return value;
+    }
+
+    [[nodiscard]] bool atEnd() const noexcept { return pos == blob.size(); }
+
+    [[nodiscard]] size_t position() const noexcept { return pos; }
+
+private:
+    void require(size_t bytes) const
+    {
+        if (blob.size() - pos < bytes)
+        {
+            throw SchemaSnapshotException("Schema snapshot is truncated");
+        }
+    }
+
+    std::string_view blob;
+    size_t pos;
+};
+
+// 64 bit FNV-1a, so the hash of a schema is the same on every platform and in every process
+class SchemaHasher
+{
+public:
+    void addByte(uint8_t value) noexcept
+    {
+        hash = (hash ^ value) * 0x100000001b3ULL;
+    }
+
+    void addU32(uint32_t value) noexcept
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            addByte(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    // length prefixed, so adjacent strings can't be confused
+    void addString(std::string_view value) noexcept
+    {
+        addU32(static_cast<uint32_t>(value.size()));
+        for (const char ch : value)
+        {
+            addByte(static_cast<uint8_t>(ch));
+        }
+    }
+
+    uint64_t hash{0xcbf29ce484222325ULL};
+};
+
+// the commands of the tree in depth-first order together with the index of their parents
+struct TreeLayout
+{
+    std::vector<const Command *> commands;
+    std::vector<uint32_t> parents;
+};
+
+inline_t TreeLayout layoutOf(const CommandTree &tree)
+{
+    TreeLayout layout{tree.getAllCommandsConst(), {}};
+    std::unordered_map<const Command *, uint32_t> indices;
+    for (size_t i = 0; i < layout.commands.size(); ++i)
+    {
+        indices.emplace(layout.commands[i], static_cast<uint32_t>(i));
+    }
+
+    layout.parents.assign(layout.commands.size(), SchemaSnapshot::noParent);
+    for (size_t i = 0; i < layout.commands.size(); ++i)
+    {
+        for (const auto &[id, subCommand] : layout.commands[i]->getSubCommands())
+        {
+            layout.parents[indices.at(subCommand.get())] = static_cast<uint32_t>(i);
+        }
+    }
+    return layout;
+}
+
+// the metadata of an argument, views into the argument
+inline_t SnapshotArgument describeArgument(const ArgumentBase &argument)
+{
+    SnapshotArgument entry{argument.getArgType(), argument.isRequired(), argument.isRepeatable(),
+                           argument.getName(), {}, {}};
+    switch (argument.getArgType())
+    {
+    case ArgumentKind::Option: {
+        const auto &option = static_cast<const OptionArgumentBase &>(argument);
+        entry.shortName = option.getShortName();
+        entry.typeName = option.getType().name();
+        break;
+    }
+    case ArgumentKind::Flag:
+        entry.shortName = static_cast<const FlagArgument &>(argument).getShortName();
+        break;
+    case ArgumentKind::Positional:
+        entry.typeName = static_cast<const PositionalArgumentBase &>(argument).getType().name();
+        break;
+    }
+    return entry;
+}
+
+inline_t uint8_t argumentFlags(const SnapshotArgument &argument)
+{
+    return static_cast<uint8_t>((argument.required ? requiredBit : 0) |
+                                (argument.repeatable ? repeatableBit : 0));
+}
+
+inline_t uint8_t groupFlags(bool exclusive, bool inclusive)
+{
+    return static_cast<uint8_t>((exclusive ? exclusiveBit : 0) | (inclusive ? inclusiveBit : 0));
+}
+
+// the schema of a command without its path and doc strings, views into the command
+inline_t SnapshotCommand describe(const Command &command, uint32_t parent)
+{
+    SnapshotCommand description{parent, command.getIdentifier(), {}, {}, {}, {}, {}};
+
+    std::unordered_map<const ArgumentBase *, uint32_t> slots;
+    const auto &arguments = command.getAllArguments();
+    description.arguments.reserve(arguments.size());
+    for (const ArgumentBase *argument : arguments)
+    {
+        slots.emplace(argument, static_cast<uint32_t>(description.arguments.size()));
+
+        description.arguments.push_back(describeArgument(*argument));
+    }
+
+    for (const auto &group : command.getArgumentGroups())
+    {
+        SnapshotGroup entry{group->isExclusive(), group->isInclusive(), {}};
+        for (const auto &argument : group->getArguments())
+        {
+            entry.members.push_back(slots.at(argument.get()));
+        }
+        description.groups.push_back(std::move(entry));
+    }
+    return description;
+}
+} // namespace detail
+
+inline_t std::string SchemaSnapshot::capture(const CommandTree &tree, const CliConfig &config)
+{
+    const detail::TreeLayout layout = detail::layoutOf(tree);
+
+    detail::SnapshotWriter writer;
+    writer.blob.append(detail::snapshotMagic);
+    writer.writeU32(detail::snapshotVersion);
+    writer.writeU64(schemaHash(tree, config));
+    writer.writeU32(static_cast<uint32_t>(layout.commands.size()));
+
+    // the commands and their doc strings first, loadHeader stops after them
+    for (size_t i = 0; i < layout.commands.size(); ++i)
+    {
+        const Command &command = *layout.commands[i];
+        writer.writeU32(layout.parents[i]);
+        writer.writeString(command.getIdentifier());
+        writer.writeString(tree.getPathForCommand(const_cast<Command *>(&command)));
+        writer.writeString(command.getDocStringShort());
+        writer.writeString(command.getDocStringLong());
+    }
+
+    for (size_t i = 0; i < layout.commands.size(); ++i)
+    {
+        const SnapshotCommand description =
+            detail::describe(*layout.commands[i], layout.parents[i]);
+
+        writer.writeU32(static_cast<uint32_t>(description.arguments.size()));
+        for (const auto &argument : description.arguments)
+        {
+            writer.writeByte(static_cast<uint8_t>(argument.kind));
+            writer.writeByte(detail::argumentFlags(argument));
+            writer.writeString(argument.name);
+            writer.writeString(argument.shortName);
+            writer.writeString(argument.typeName);
+        }
+
+        writer.writeU32(static_cast<uint32_t>(description.groups.size()));
+        for (const auto &group : description.groups)
+        {
+            writer.writeByte(detail::groupFlags(group.exclusive, group.inclusive));
+            writer.writeU32(static_cast<uint32_t>(group.members.size()));
+            for (const uint32_t member : group.members)
+            {
+                writer.writeU32(member);
+            }
+        }
+    }
+    return std::move(writer.blob);
+}
+
+inline_t SchemaSnapshot SchemaSnapshot::loadCommands(std::string_view blob, size_t &schemaStart)
+{
+    if (!blob.starts_with(detail::snapshotMagic))
+    {
+        throw SchemaSnapshotException("Not a schema snapshot");
+    }
+    detail::SnapshotReader reader(blob, detail::snapshotMagic.size());
+    if (const uint32_t version = reader.readU32(); version != detail::snapshotVersion)
+    {
+        throw SchemaSnapshotException(
+            std::format("Unsupported schema snapshot version {}, expected {}", version,
+                        detail::snapshotVersion));
+    }
+
+    SchemaSnapshot snapshot;
+    snapshot.hash = reader.readU64();
+    const uint32_t commandCount = reader.readU32();
+    // every command takes at least 20 bytes, so a corrupt count can't reserve huge amounts
+    snapshot.commands.reserve(std::min<size_t>(commandCount, blob.size() / 20));
+    for (uint32_t i = 0; i < commandCount; ++i)
+    {
+        SnapshotCommand command{reader.readU32(), reader.readString(), reader.readString(),
+                                reader.readString(), reader.readString(), {}, {}};
+        if (command.parent != noParent && command.parent >= i)
+        {
+            throw SchemaSnapshotException(
+                std::format("Command {} of the schema snapshot has an invalid parent", i));
+        }
+        snapshot.commands.push_back(command);
+    }
+    schemaStart = reader.position();
+    return snapshot;
+}
+
+inline_t SchemaSnapshot SchemaSnapshot::loadHeader(std::string_view blob)
+{
+    size_t schemaStart = 0;
+    return loadCommands(blob, schemaStart);
+}
+
+inline_t SchemaSnapshot SchemaSnapshot::load(std::string_view blob)
+{
+    size_t schemaStart = 0;
+    SchemaSnapshot snapshot = loadCommands(blob, schemaStart);
+
+    detail::SnapshotReader reader(blob, schemaStart);
+    for (auto &command : snapshot.commands)
+    {
+        const uint32_t argumentCount = reader.readU32();
+        for (uint32_t a = 0; a < argumentCount; ++a)
+        {
+            const uint8_t kind = reader.readByte();
+            if (kind > static_cast<uint8_t>(ArgumentKind::Flag))
+            {
+                throw SchemaSnapshotException("Schema snapshot contains an unknown argument kind");
+            }
+            const uint8_t flags = reader.readByte();
+            command.arguments.push_back(SnapshotArgument{
+                static_cast<ArgumentKind>(kind), (flags & detail::requiredBit) != 0,
+                (flags & detail::repeatableBit) != 0, reader.readString(), reader.readString(),
+                reader.readString()});
+        }
+
+        const uint32_t groupCount = reader.readU32();
+        for (uint32_t g = 0; g < groupCount; ++g)
+        {
+            const uint8_t flags = reader.readByte();
+            SnapshotGroup group{(flags & detail::exclusiveBit) != 0,
+                                (flags & detail::inclusiveBit) != 0, {}};
+            const uint32_t memberCount = reader.readU32();
+            for (uint32_t m = 0; m < memberCount; ++m)
+            {
+                group.members.push_back(reader.readU32());
+            }
+            command.groups.push_back(std::move(group));
+        }
+    }
+
+    if (!reader.atEnd())
+    {
+        throw SchemaSnapshotException("Schema snapshot has trailing data");
+    }
+    return snapshot;
+}
+
+inline_t uint64_t SchemaSnapshot::schemaHash(const CommandTree &tree, const CliConfig &config)
+{
+    detail::SchemaHasher hasher;
+    // the only field of the configuration the default formatters render commands with
+    hasher.addU32(static_cast<uint32_t>(config.optionsWidth));
+
+    // the depth-first order and the number of subcommands of every command determine the
+    // hierarchy, so no parent indices have to be computed
+    tree.forEachCommand([&hasher](const Command &command) {
+        hasher.addString(command.getIdentifier());
+        hasher.addString(command.getShortDescription());
+        hasher.addString(command.getLongDescription());
+        hasher.addU32(static_cast<uint32_t>(command.getSubCommands().size()));
+
+        const auto &arguments = command.getAllArguments();
+        hasher.addU32(static_cast<uint32_t>(arguments.size()));
+        for (const ArgumentBase *argument : arguments)
+        {
+            const SnapshotArgument entry = detail::describeArgument(*argument);
+            hasher.addByte(static_cast<uint8_t>(entry.kind));
+            hasher.addByte(detail::argumentFlags(entry));
+            hasher.addString(entry.name);
+            hasher.addString(entry.shortName);
+            hasher.addString(entry.typeName);
+            hasher.addString(argument->getOptionComment());
+            if (entry.kind == ArgumentKind::Option)
+            {
+                hasher.addString(static_cast<const OptionArgumentBase *>(argument)->getValueName());
+            }
+        }
+
+        // members are hashed by name, which avoids mapping the arguments to their slots
+        hasher.addU32(static_cast<uint32_t>(command.getArgumentGroups().size()));
+        for (const auto &group : command.getArgumentGroups())
+        {
+            hasher.addByte(detail::groupFlags(group->isExclusive(), group->isInclusive()));
+            hasher.addU32(static_cast<uint32_t>(group->getArguments().size()));
+            for (const auto &argument : group->getArguments())
+            {
+                hasher.addString(argument->getName());
+            }
+        }
+    });
+    return hasher.hash;
+}
+
+inline_t void SchemaSnapshot::verify(const CommandTree &tree, const CliConfig &config) const
+{
+    if (schemaHash(tree, config) != hash)
+    {
+        throw SchemaSnapshotException(
+            "Schema snapshot does not match the commands or the help of the application");
+    }
+}
+
+inline_t void SchemaSnapshot::writeSource(std::ostream &out, std::string_view blob,
+                                          std::string_view variableName)
+{
+    // octal escapes have at most three digits, so they can't swallow the following characters
+    out << "inline constexpr std::string_view " << variableName << "{\n    \"";
+    size_t column = 0;
+    for (const char ch : blob)
+    {
+        const auto byte = static_cast<unsigned char>(ch);
+        out << '\\' << static_cast<char>('0' + ((byte >> 6) & 7))
+            << static_cast<char>('0' + ((byte >> 3) & 7)) << static_cast<char>('0' + (byte & 7));
+        if (++column == 24)
+        {
+            out << "\"\n    \"";
+            column = 0;
+        }
+    }
+    out << "\",\n    " << blob.size() << "};\n";
+}
+} // namespace cli::commands
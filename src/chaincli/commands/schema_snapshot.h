@@ -0,0 +1,162 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "argument.h"
+#include "cli_config.h"
+
+namespace cli::commands
+{
+class CommandTree;
+
+/// @brief Exception thrown when a schema snapshot is malformed or does not match the commands it
+/// is loaded for.
+class SchemaSnapshotException : public std::runtime_error
+{
+public:
+    /// @brief Construct a SchemaSnapshotException with a message.
+    /// @param message The error message.
+    explicit SchemaSnapshotException(const std::string &message) : std::runtime_error(message) {}
+};
+
+/// @brief Metadata of an argument stored in a schema snapshot.
+struct SnapshotArgument
+{
+    ArgumentKind kind;
+    bool required;
+    bool repeatable;
+    std::string_view name;
+    std::string_view shortName; // empty for positional arguments
+    std::string_view typeName;  // empty for flags
+
+    bool operator==(const SnapshotArgument &) const = default;
+};
+
+/// @brief An argument group stored in a schema snapshot.
+struct SnapshotGroup
+{
+    bool exclusive;
+    bool inclusive;
+    std::vector<uint32_t> members; // slots of the member arguments
+
+    bool operator==(const SnapshotGroup &) const = default;
+};
+
+/// @brief A command stored in a schema snapshot.
+struct SnapshotCommand
+{
+    uint32_t parent; // index of the parent command, SchemaSnapshot::noParent for the root
+    std::string_view identifier;
+    std::string_view path;
+    std::string_view docStringShort;
+    std::string_view docStringLong;
+    std::vector<SnapshotArgument> arguments; // in slot order
+    std::vector<SnapshotGroup> groups;
+};
+
+/// @brief Compact binary snapshot of an initialized command schema.
+/// @details A snapshot contains the command hierarchy, the metadata of all arguments, the argument
+/// groups and the rendered documentation strings, together with a hash of the schema. Argument
+/// types and execution functions only exist in code, so a snapshot does not replace defining the
+/// commands; loading it into a CliApp with the same commands (see CliApp::loadSchemaSnapshot) lets
+/// the app skip rendering the help and building the per command state during initialization. The
+/// commands are checked against the snapshot by comparing the stored hash only, which also covers
+/// everything the help is rendered from, and the help is used in place, so the blob is best
+/// embedded into the binary as a constexpr std::string_view generated by writeSource.
+/// @note Custom doc formatters (see DocWriter) are not part of the hash, a snapshot has to be
+/// captured again after replacing them.
+class SchemaSnapshot
+{
+public:
+    /// @brief Parent index of the root command.
+    static constexpr uint32_t noParent = UINT32_MAX;
+
+    /// @brief Serialize the schema of a command tree.
+    /// @note The command paths of the tree have to be built (see CommandTree::buildCommandPathMap)
+    /// and its commands must be able to provide their doc strings.
+    /// @param tree The tree to serialize.
+    /// @param config The configuration the doc strings were rendered with.
+    /// @return The snapshot blob.
+    static std::string capture(const CommandTree &tree, const CliConfig &config);
+
+    /// @brief Parse a snapshot blob.
+    /// @param blob The blob created by capture, it has to outlive the returned snapshot since all
+    /// strings are views into it.
+    /// @return The parsed snapshot.
+    /// @throws SchemaSnapshotException if the blob is malformed or of an unsupported version.
+    static SchemaSnapshot load(std::string_view blob);
+
+    /// @brief Parse only the commands and their doc strings of a snapshot blob.
+    /// @details The argument metadata and groups are skipped, the commands of the returned
+    /// snapshot have none. This is all that is needed to initialize an application from the
+    /// snapshot, the schema is checked with the stored hash (see verify).
+    /// @param blob The blob created by capture, it has to outlive the returned snapshot since all
+    /// strings are views into it.
+    /// @return The parsed snapshot without argument metadata.
+    /// @throws SchemaSnapshotException if the blob is malformed or of an unsupported version.
+    static SchemaSnapshot loadHeader(std::string_view blob);
+
+    /// @brief Compute the hash of the schema of a command tree, as stored by capture.
+    /// @details Covers the hierarchy, identifiers and descriptions of the commands, the kind,
+    /// names, type, flags, value name and comment of every argument, the argument groups and the
+    /// fields of the configuration the doc strings depend on. So the hash changes whenever the
+    /// rendered help would, without rendering it.
+    /// @param tree The tree to hash.
+    /// @param config The configuration the doc strings are rendered with.
+    /// @return The 64 bit FNV-1a hash of the schema.
+    static uint64_t schemaHash(const CommandTree &tree, const CliConfig &config);
+
+    /// @brief Write a C++ definition of a blob as a constexpr std::string_view.
+    /// @param out The stream to write the definition to.
+    /// @param blob The blob to embed.
+    /// @param variableName The name of the defined variable.
+    static void writeSource(std::ostream &out, std::string_view blob,
+                            std::string_view variableName);
+
+    /// @brief Get the commands of the snapshot in depth-first order, the root comes first.
+    /// @return The commands.
+    [[nodiscard]] const std::vector<SnapshotCommand> &getCommands() const noexcept
+    {
+        return commands;
+    }
+
+    /// @brief Get the hash of the schema the snapshot was captured from.
+    /// @return The stored schema hash, see schemaHash.
+    [[nodiscard]] uint64_t getSchemaHash() const noexcept { return hash; }
+
+    /// @brief Check that a command tree has the schema stored in this snapshot.
+    /// @details Only the stored hash is compared with the hash of the tree, nothing is decoded.
+    /// @param tree The tree to compare with.
+    /// @param config The configuration the doc strings would be rendered with.
+    /// @throws SchemaSnapshotException if the schemas or the inputs of the doc strings differ.
+    void verify(const CommandTree &tree, const CliConfig &config) const;
+
+private:
+    // reads everything up to the argument metadata, which starts at the returned position
+    static SchemaSnapshot loadCommands(std::string_view blob, size_t &schemaStart);
+
+    std::vector<SnapshotCommand> commands;
+    uint64_t hash{0};
+};
+
+} // namespace cli::commands
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace cli::commands
+{
+
+/// @brief Dynamically sized set of argument slots, stored as a bitset.
+/// @details Every argument of a command has a dense slot index (see ArgumentIndex), so sets of
+/// arguments (e.g. the ones present in a parsed context) can be represented by one bit per slot.
+class SlotSet
+{
+public:
+    /// @brief Construct an empty set that can hold the slots [0, size).
+    /// @param size The number of slots the set can hold.
+    /// @param resource The memory resource to allocate the bits from.
+    explicit SlotSet(size_t size = 0,
+                     std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : bits(wordCount(size), resource), slotCount(size)
+    {
+    }
+
+    /// @brief Get the number of slots the set can hold.
+    /// @return The number of slots.
+    [[nodiscard]] size_t size() const noexcept { return slotCount; }
+
+    /// @brief Change the number of slots the set can hold, newly added slots are not contained.
+    /// @param size The new number of slots.
+    void resize(size_t size)
+    {
+        bits.resize(wordCount(size));
+        slotCount = size;
+    }
+
+    /// @brief Add a slot to the set.
+    /// @param slot The slot to add, has to be smaller than size().
+    void insert(size_t slot) noexcept { bits[slot / wordBits] |= bitFor(slot); }
+
+    /// @brief Check if a slot is contained in the set.
+    /// @param slot The slot to check.
+    /// @return True if the slot is contained, false otherwise (also if it is out of range).
+    [[nodiscard]] bool contains(size_t slot) const noexcept
+    {
+        return slot < slotCount && (bits[slot / wordBits] & bitFor(slot)) != 0;
+    }
+
+    /// @brief Count the slots contained in the set.
+    /// @return The number of contained slots.
+    [[nodiscard]] size_t count() const noexcept
+    {
+        size_t result = 0;
+        for (auto word : bits)
+        {
+            result += static_cast<size_t>(std::popcount(word));
+        }
+        return result;
+    }
+
+    /// @brief Count the slots contained in both this and another set.
+    /// @param other The set to intersect with.
+    /// @return The number of slots contained in both sets.
+    [[nodiscard]] size_t countCommon(const SlotSet &other) const noexcept
+    {
+        size_t result = 0;
+        const size_t words = std::min(bits.size(), other.bits.size());
+        for (size_t i = 0; i < words; ++i)
+        {
+            result += static_cast<size_t>(std::popcount(bits[i] & other.bits[i]));
+        }
+        return result;
+    }
+
+    /// @brief Check if every slot of this set is also contained in another set.
+    /// @param other The set to compare with.
+    /// @return True if this set is a subset of other, false otherwise.
+    [[nodiscard]] bool isSubsetOf(const SlotSet &other) const noexcept
+    {
+        for (size_t i = 0; i < bits.size(); ++i)
+        {
+            const uint64_t otherWord = i < other.bits.size() ? other.bits[i] : 0;
+            if ((bits[i] & ~otherWord) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Remove all slots from the set while keeping its size.
+    void clear() noexcept
+    {
+        for (auto &word : bits)
+        {
+            word = 0;
+        }
+    }
+
+private:
+    static constexpr size_t wordBits = 64;
+
+    static constexpr size_t wordCount(size_t size) noexcept
+    {
+        return (size + wordBits - 1) / wordBits;
+    }
+
+    static constexpr uint64_t bitFor(size_t slot) noexcept
+    {
+        return uint64_t{1} << (slot % wordBits);
+    }
+
+    std::pmr::vector<uint64_t> bits;
+    size_t slotCount;
+};
+
+} // namespace cli::commands
@@ -0,0 +1,410 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "command.h"
+#include "flag_argument.h"
+#include "logging/logger.h"
+#include "option_argument.h"
+#include "parsing/parse_exception.h"
+#include "parsing/parser_utils.h"
+#include "positional_argument.h"
+#include "suggestion_index.h"
+
+namespace cli::commands
+{
+
+/// @brief String literal that can be used as a template argument.
+/// @tparam N The size of the literal including the terminating null character.
+template <size_t N> struct FixedString
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays, google-explicit-constructor)
+    constexpr FixedString(const char (&str)[N]) { std::copy_n(str, N, value); }
+
+    /// @brief Get the string without the terminating null character.
+    /// @return A view of the string.
+    [[nodiscard]] constexpr std::string_view view() const noexcept { return {value, N - 1}; }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+    char value[N]{};
+};
+
+/// @brief Argument descriptions used to declare the schema of a StaticCommand.
+namespace schema
+{
+/// @brief Option argument of a StaticCommand, parsed into a std::optional<T>.
+/// @tparam T The type of the option's value.
+/// @tparam Name The name of the option (usually starts with "--").
+/// @tparam ShortName The short name of the option (usually starts with "-"), may be empty.
+/// @tparam Required Whether the option is required.
+template <typename T, FixedString Name, FixedString ShortName = "", bool Required = false>
+struct Option
+{
+    using value_type = T;
+    using stored_type = std::optional<T>;
+    static constexpr ArgumentKind kind = ArgumentKind::Option;
+    static constexpr std::string_view name = Name.view();
+    static constexpr std::string_view shortName = ShortName.view();
+    static constexpr bool required = Required;
+
+    static void addTo(Command &command)
+    {
+        command.withOptionArgument(OptionArgument<T>(name, "value", shortName, "", required));
+    }
+};
+
+/// @brief Flag argument of a StaticCommand, parsed into a bool.
+/// @tparam Name The name of the flag (usually starts with "--").
+/// @tparam ShortName The short name of the flag (usually starts with "-"), may be empty.
+template <FixedString Name, FixedString ShortName = ""> struct Flag
+{
+    using value_type = bool;
+    using stored_type = bool;
+    static constexpr ArgumentKind kind = ArgumentKind::Flag;
+    static constexpr std::string_view name = Name.view();
+    static constexpr std::string_view shortName = ShortName.view();
+    static constexpr bool required = false;
+
+    static void addTo(Command &command)
+    {
+        command.withFlagArgument(FlagArgument(name, shortName));
+    }
+};
+
+/// @brief Positional argument of a StaticCommand, parsed into a std::optional<T>.
+/// @details Positional arguments are assigned in the order they appear in the schema.
+/// @tparam T The type of the argument's value.
+/// @tparam Name The name of the argument.
+/// @tparam Required Whether the argument is required.
+template <typename T, FixedString Name, bool Required = true> struct Positional
+{
+    using value_type = T;
+    using stored_type = std::optional<T>;
+    static constexpr ArgumentKind kind = ArgumentKind::Positional;
+    static constexpr std::string_view name = Name.view();
+    static constexpr std::string_view shortName{};
+    static constexpr bool required = Required;
+
+    static void addTo(Command &command)
+    {
+        command.withPositionalArgument(PositionalArgument<T>(name, "", required));
+    }
+};
+} // namespace schema
+
+template <FixedString Identifier, typename... Args> class StaticCommand;
+
+/// @brief Typed result of parsing the inputs of a StaticCommand.
+/// @details Holds one value per schema argument: std::optional<T> for options and positional
+/// arguments and bool for flags. Values are accessed by name, which is resolved at compile time.
+/// @tparam Args The schema arguments of the command.
+template <typename... Args> class StaticResult
+{
+    template <FixedString Identifier, typename... CommandArgs> friend class StaticCommand;
+
+public:
+    /// @brief Get the value of the schema argument with the given name.
+    /// @tparam Name The (long) name of the argument.
+    /// @return A reference to the stored value of the argument.
+    template <FixedString Name> [[nodiscard]] constexpr const auto &get() const noexcept
+    {
+        static_assert(indexOf(Name.view()) < sizeof...(Args), "No argument with this name");
+        return std::get<indexOf(Name.view())>(values);
+    }
+
+    /// @brief Get the value of the schema argument with the given name.
+    /// @tparam Name The (long) name of the argument.
+    /// @return A reference to the stored value of the argument.
+    template <FixedString Name> [[nodiscard]] constexpr auto &get() noexcept
+    {
+        static_assert(indexOf(Name.view()) < sizeof...(Args), "No argument with this name");
+        return std::get<indexOf(Name.view())>(values);
+    }
+
+    /// @brief Get all values in the order of the schema (e.g. for structured bindings).
+    /// @return A reference to the tuple of all values.
+    [[nodiscard]] constexpr const auto &asTuple() const noexcept { return values; }
+
+private:
+    static consteval size_t indexOf(std::string_view name)
+    {
+        constexpr std::array<std::string_view, sizeof...(Args)> names{Args::name...};
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            if (names[i] == name)
+                return i;
+        }
+        return sizeof...(Args);
+    }
+
+    std::tuple<typename Args::stored_type...> values;
+};
+
+/// @brief Command whose arguments are declared at compile time.
+/// @details The schema is given as template arguments, e.g.
+/// `StaticCommand<"build", schema::Option<int, "--jobs", "-j">, schema::Flag<"--verbose", "-v">>`.
+/// Inputs are matched by comparisons that are unrolled at compile time and converted with
+/// ParseHelper directly into a StaticResult, without std::any, virtual calls or a CliContext (only
+/// values of types that own memory, like std::string, allocate; std::string_view values view the
+/// inputs instead).
+/// The schema arguments are also added as regular arguments, so the command can be mounted
+/// anywhere in a CommandTree (through a std::unique_ptr) and gets doc strings and help output like
+/// any other command.
+/// @note No further arguments should be added to a StaticCommand, they would not be parsed.
+/// @tparam Identifier The identifier of the command.
+/// @tparam Args The schema arguments (schema::Option, schema::Flag and schema::Positional).
+template <FixedString Identifier, typename... Args> class StaticCommand : public Command
+{
+public:
+    using Result = StaticResult<Args...>;
+    using Action = std::function<void(const Result &, logging::AbstractLogger &)>;
+
+    /// @brief Construct a new StaticCommand.
+    /// @param action The function to execute with the parsed result when the command is called.
+    explicit StaticCommand(Action action = nullptr) : Command(Identifier.view())
+    {
+        (Args::addTo(*this), ...);
+        if (action)
+        {
+            auto sharedAction = std::make_shared<Action>(std::move(action));
+            this->action = sharedAction;
+            // used if the command is executed with a CliContext instead of its own parser
+            withExecutionFunc([sharedAction](const CliContext &context) {
+                (*sharedAction)(fromContext(context), context.Logger());
+            });
+        }
+    }
+
+    /// @brief Parse the inputs according to the schema of the command.
+    /// @param inputs The inputs passed to the command (without the command path).
+    /// @param suggestionLimit The number of closest names suggested for a mistyped option, see
+    /// CliConfig::suggestionLimit.
+    /// @return The parsed values.
+    /// @throws parsing::ParseException if an option has no value, a non repeatable argument is
+    /// repeated or a required argument is missing.
+    /// @throws parsing::TypeParseException if a value can not be converted to its type.
+    /// @throws parsing::UnknownInputException if an input matches no argument, like the Parser an
+    /// input that looks like an option is reported as unknown argument together with the closest
+    /// option and flag names.
+    [[nodiscard]] Result parse(std::span<const std::string_view> inputs,
+                               size_t suggestionLimit = 3) const
+    {
+        Result result;
+        size_t position = 0;
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            if (!matchNamed(result, inputs, i, std::index_sequence_for<Args...>{}) &&
+                !matchPositional(result, inputs[i], position++, std::index_sequence_for<Args...>{}))
+            {
+                throwUnmatched(inputs[i], suggestionLimit);
+            }
+        }
+        checkRequired(result, std::index_sequence_for<Args...>{});
+        return result;
+    }
+
+    [[nodiscard]] bool hasOwnParser() const noexcept override { return action != nullptr; }
+
+    void executeWithOwnParser(std::span<const std::string_view> inputs,
+                              logging::AbstractLogger &logger,
+                              size_t suggestionLimit) const override
+    {
+        if (!action)
+        {
+            Command::executeWithOwnParser(inputs, logger, suggestionLimit);
+            return;
+        }
+        (*action)(parse(inputs, suggestionLimit), logger);
+    }
+
+private:
+    template <size_t I> using ArgAt = std::tuple_element_t<I, std::tuple<Args...>>;
+
+    std::shared_ptr<Action> action;
+
+    // the schema arguments are added first, so the I-th one is in slot I
+    const ArgumentBase &argumentAt(size_t index) const { return *getAllArguments()[index]; }
+
+    static constexpr size_t positionalCount =
+        ((Args::kind == ArgumentKind::Positional ? 1 : 0) + ... + 0);
+
+    [[noreturn]] void throwUnmatched(std::string_view input, size_t suggestionLimit) const
+    {
+        // an input that looks like an option or that a command without positional arguments
+        // gets is most likely a mistyped option, with the same wording as the Parser
+        if (positionalCount == 0 || input.starts_with('-'))
+        {
+            std::string message = std::format("Unknown argument: {}", input);
+            if (const auto suggestions =
+                    formatSuggestions(getArgumentIndex().suggest(input, suggestionLimit));
+                !suggestions.empty())
+            {
+                message += ". " + suggestions;
+            }
+            throw parsing::UnknownInputException(message, input);
+        }
+        throw parsing::UnknownInputException(
+            std::format("More positional arguments were provided than the command accepts with "
+                        "input: {}",
+                        input),
+            input);
+    }
+
+    template <size_t I> static consteval size_t positionalOrdinal()
+    {
+        constexpr std::array<bool, sizeof...(Args)> isPositional{
+            (Args::kind == ArgumentKind::Positional)...};
+        size_t ordinal = 0;
+        for (size_t i = 0; i < I; ++i)
+        {
+            ordinal += isPositional[i] ? 1 : 0;
+        }
+        return ordinal;
+    }
+
+    template <size_t... I>
+    bool matchNamed(Result &result, std::span<const std::string_view> inputs, size_t &index,
+                    std::index_sequence<I...> /*unused*/) const
+    {
+        return (matchNamedAt<I>(result, inputs, index) || ...);
+    }
+
+    template <size_t I>
+    bool matchNamedAt(Result &result, std::span<const std::string_view> inputs,
+                      size_t &index) const
+    {
+        using Arg = ArgAt<I>;
+        if constexpr (Arg::kind == ArgumentKind::Positional)
+        {
+            return false;
+        }
+        else
+        {
+            std::string_view input = inputs[index];
+            if (input != Arg::name && (Arg::shortName.empty() || input != Arg::shortName))
+            {
+                return false;
+            }
+
+            auto &value = std::get<I>(result.values);
+            if constexpr (Arg::kind == ArgumentKind::Flag)
+            {
+                value = true;
+            }
+            else
+            {
+                if (index + 1 >= inputs.size())
+                {
+                    throw parsing::ParseException(
+                        std::format("Option {} requires a value but none was provided", input), "",
+                        argumentAt(I));
+                }
+                if (value.has_value())
+                {
+                    throw parsing::ParseException(
+                        std::format("Non Repeatable Argument {} was repeated", Arg::name),
+                        inputs[index + 1], argumentAt(I));
+                }
+                value = parsing::ParseHelper::parse<typename Arg::value_type>(inputs[++index]);
+            }
+            return true;
+        }
+    }
+
+    template <size_t... I>
+    static bool matchPositional(Result &result, std::string_view input, size_t position,
+                                std::index_sequence<I...> /*unused*/)
+    {
+        return (matchPositionalAt<I>(result, input, position) || ...);
+    }
+
+    template <size_t I>
+    static bool matchPositionalAt(Result &result, std::string_view input, size_t position)
+    {
+        using Arg = ArgAt<I>;
+        if constexpr (Arg::kind == ArgumentKind::Positional)
+        {
+            if (position == positionalOrdinal<I>())
+            {
+                std::get<I>(result.values) =
+                    parsing::ParseHelper::parse<typename Arg::value_type>(input);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <size_t... I>
+    void checkRequired(const Result &result, std::index_sequence<I...> /*unused*/) const
+    {
+        (checkRequiredAt<I>(result), ...);
+    }
+
+    template <size_t I> void checkRequiredAt(const Result &result) const
+    {
+        using Arg = ArgAt<I>;
+        if constexpr (Arg::required)
+        {
+            if (!std::get<I>(result.values))
+            {
+                throw parsing::ParseException(
+                    std::format("Required argument {} is missing", Arg::name), "", argumentAt(I));
+            }
+        }
+    }
+
+    static Result fromContext(const CliContext &context)
+    {
+        Result result;
+        fillFromContext(result, context, std::index_sequence_for<Args...>{});
+        return result;
+    }
+
+    template <size_t... I>
+    static void fillFromContext(Result &result, const CliContext &context,
+                                std::index_sequence<I...> /*unused*/)
+    {
+        (fillFromContextAt<I>(result, context), ...);
+    }
+
+    template <size_t I> static void fillFromContextAt(Result &result, const CliContext &context)
+    {
+        using Arg = ArgAt<I>;
+        const std::string name(Arg::name);
+        if constexpr (Arg::kind == ArgumentKind::Flag)
+        {
+            std::get<I>(result.values) = context.isFlagPresent(name);
+        }
+        else if (context.isArgPresent(name))
+        {
+            std::get<I>(result.values) = context.getArg<typename Arg::value_type>(name);
+        }
+    }
+};
+
+} // namespace cli::commands
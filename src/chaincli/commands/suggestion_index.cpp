@@ -0,0 +1,173 @@
+// Copyright 2025 Dominik Czekai
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "suggestion_index.h"
+
+#include <algorithm>
+#include <tuple>
+
+#define inline_t
+
+namespace cli::commands
+{
+inline_t size_t SuggestionIndex::defaultMaxDistance(std::string_view name) noexcept
+{
+    return std::clamp<size_t>(name.size() / 3, 1, 3);
+}
+
+inline_t size_t SuggestionIndex::distance(std::string_view lhs, std::string_view rhs, size_t bound)
+{
+    if (lhs.size() < rhs.size())
+    {
+        std::swap(lhs, rhs);
+    }
+    // the distance is at least the difference of the lengths
+    if (lhs.size() - rhs.size() > bound)
+    {
+        return bound + 1;
+    }
+
+    // a single row of the distance matrix over the shorter string
+    std::vector<size_t> row(rhs.size() + 1);
+    for (size_t j = 0; j < row.size(); ++j)
+    {
+        row[j] = j;
+    }
+    for (size_t i = 1; i <= lhs.size(); ++i)
+    {
+        size_t diagonal = row[0];
+        row[0] = i;
+        size_t rowMinimum = row[0];
+        for (size_t j = 1; j <= rhs.size(); ++j)
+        {
+            const size_t above = row[j];
+            row[j] = std::min({above + 1, row[j - 1] + 1,
+                               diagonal + (lhs[i - 1] == rhs[j - 1] ? 0 : 1)});
+            diagonal = above;
+            rowMinimum = std::min(rowMinimum, row[j]);
+        }
+        // the values of a row never decrease in the following rows
+        if (rowMinimum > bound)
+        {
+            return bound + 1;
+        }
+    }
+    return row.back();
+}
+
+inline_t void SuggestionIndex::insert(std::string_view name)
+{
+    if (nodes.empty())
+    {
+        nodes.push_back(Node{name, 0, none, none});
+        return;
+    }
+
+    uint32_t current = 0;
+    while (true)
+    {
+        const size_t dist = distance(name, nodes[current].name);
+        if (dist == 0)
+        {
+            return;
+        }
+
+        uint32_t child = nodes[current].firstChild;
+        while (child != none && nodes[child].distanceToParent != dist)
+        {
+            child = nodes[child].nextSibling;
+        }
+        if (child == none)
+        {
+            const auto added = static_cast<uint32_t>(nodes.size());
+            nodes.push_back(
+                Node{name, static_cast<uint32_t>(dist), none, nodes[current].firstChild});
+            nodes[current].firstChild = added;
+            return;
+        }
+        current = child;
+    }
+}
+
+inline_t std::vector<SuggestionIndex::Suggestion> SuggestionIndex::closest(std::string_view name,
+                                                                           size_t limit,
+                                                                           size_t maxDistance) const
+{
+    std::vector<Suggestion> matches;
+    if (nodes.empty() || limit == 0)
+    {
+        return matches;
+    }
+    if (maxDistance == npos)
+    {
+        maxDistance = defaultMaxDistance(name);
+    }
+
+    std::vector<uint32_t> pending{0};
+    while (!pending.empty())
+    {
+        const Node &node = nodes[pending.back()];
+        pending.pop_back();
+
+        // the exact distance is needed to select the children
+        const size_t dist = distance(name, node.name);
+        if (dist <= maxDistance)
+        {
+            matches.push_back(Suggestion{node.name, dist});
+        }
+
+        // by the triangle inequality only children within maxDistance of dist can match
+        const size_t low = dist > maxDistance ? dist - maxDistance : 0;
+        const size_t high = dist + maxDistance;
+        for (uint32_t child = node.firstChild; child != none; child = nodes[child].nextSibling)
+        {
+            if (nodes[child].distanceToParent >= low && nodes[child].distanceToParent <= high)
+            {
+                pending.push_back(child);
+            }
+        }
+    }
+
+    std::ranges::sort(matches, {}, [](const Suggestion &match) {
+        return std::tie(match.distance, match.name);
+    });
+    if (matches.size() > limit)
+    {
+        matches.resize(limit);
+    }
+    return matches;
+}
+
+inline_t std::string formatSuggestions(const std::vector<std::string_view> &names)
+{
+    if (names.empty())
+    {
+        return {};
+    }
+
+    std::string sentence = "Did you mean";
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        if (i > 0)
+        {
+            sentence += i + 1 == names.size() ? " or" : ",";
+        }
+        sentence += " '";
+        sentence += names[i];
+        sentence += "'";
+    }
+    return sentence + "?";
+}
+
+} // namespace cli::commands
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cli::commands
+{
+/// @brief Edit distance index (a BK-tree) over a set of names, used to suggest the closest known
+/// names for a mistyped one.
+/// @details The edit distance is the Levenshtein distance. Since it is a metric, a lookup only
+/// descends into the children whose distance to their parent lies within the allowed distance of
+/// the distance between the parent and the looked up name, so only a small part of the tree is
+/// visited for the small distances typical for typos, independent of the number of names.
+/// @note The names are only viewed, they have to outlive the index.
+class SuggestionIndex
+{
+public:
+    /// @brief A name of the index that is close to the looked up one.
+    struct Suggestion
+    {
+        std::string_view name;
+        size_t distance;
+    };
+
+    /// @brief Add a name to the index, names that are already contained are ignored.
+    /// @param name The name to add.
+    void insert(std::string_view name);
+
+    /// @brief Remove all names from the index.
+    void clear() noexcept { nodes.clear(); }
+
+    /// @brief Get the number of names in the index.
+    /// @return The number of distinct names.
+    [[nodiscard]] size_t size() const noexcept { return nodes.size(); }
+
+    /// @brief Find the names closest to the given one.
+    /// @param name The (mistyped) name to find suggestions for.
+    /// @param limit The maximum number of suggestions.
+    /// @param maxDistance The maximum edit distance of a suggestion, defaultMaxDistance(name) is
+    /// used if npos.
+    /// @return At most limit suggestions, sorted by their distance and then by name.
+    [[nodiscard]] std::vector<Suggestion> closest(std::string_view name, size_t limit,
+                                                  size_t maxDistance = npos) const;
+
+    /// @brief Maximum distance considered a typo: a third of the length, between 1 and 3.
+    /// @param name The mistyped name.
+    /// @return The maximum edit distance.
+    [[nodiscard]] static size_t defaultMaxDistance(std::string_view name) noexcept;
+
+    /// @brief Compute the Levenshtein distance between two strings.
+    /// @param lhs The first string.
+    /// @param rhs The second string.
+    /// @param bound Computation stops early once the distance is known to exceed the bound.
+    /// @return The distance, or a value greater than bound if it exceeds the bound.
+    [[nodiscard]] static size_t distance(std::string_view lhs, std::string_view rhs,
+                                         size_t bound = npos);
+
+    /// @brief Value used for "no limit".
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+private:
+    static constexpr uint32_t none = static_cast<uint32_t>(-1);
+
+    // the children of a node are a singly linked list, so a node needs no allocation of its own
+    struct Node
+    {
+        std::string_view name;
+        uint32_t distanceToParent;
+        uint32_t firstChild;
+        uint32_t nextSibling;
+    };
+
+    std::vector<Node> nodes;
+};
+
+/// @brief Format suggested names as a sentence for an error message.
+/// @param names The suggested names, the closest first.
+/// @return E.g. "Did you mean 'add' or 'adopt'?", an empty string if there are no names.
+std::string formatSuggestions(const std::vector<std::string_view> &names);
+
+} // namespace cli::commands
@@ -14,6 +14,9 @@
 
 #include "context_builder.h"
 
+#include <format>
+#include <stdexcept>
+
 #ifdef CHAIN_CLI_VERBOSE
 #include <iostream>
 #endif
@@ -22,123 +25,217 @@
 
 namespace cli
 {
-inline_t ContextBuilder::ContextBuilder()
-    : positionalArgs(std::make_unique<std::unordered_map<std::string, std::any>>()),
-      optionalArgs(std::make_unique<std::unordered_map<std::string, std::any>>()),
-      flagArgs(std::make_unique<std::unordered_set<std::string>>())
+inline_t ContextBuilder::ContextBuilder(std::pmr::memory_resource *resource)
+    : values(resource), presentSlots(0, resource)
 {
 }
 
-inline_t ContextBuilder &ContextBuilder::addPositionalArgument(const std::string &argName, std::any &val)
+inline_t ContextBuilder::ContextBuilder(const commands::ArgumentIndex &argumentIndex,
+                                        std::pmr::memory_resource *resource)
+    : ContextBuilder(resource)
+{
+    bind(argumentIndex);
+}
+
+inline_t void ContextBuilder::bind(const commands::ArgumentIndex &index)
+{
+    if (argumentIndex == &index && values.size() == index.slotCount())
+    {
+        return;
+    }
+    unboundIndex.reset();
+    argumentIndex = &index;
+    values.assign(index.slotCount(), std::any{});
+    presentSlots = commands::SlotSet(index.slotCount(), getMemoryResource());
+}
+
+inline_t ContextBuilder &ContextBuilder::setValue(size_t slot, std::any val)
 {
+    values[slot] = std::move(val);
+    presentSlots.insert(slot);
+    return *this;
+}
+
+inline_t ContextBuilder &ContextBuilder::appendValues(size_t slot, std::pmr::vector<std::any> vals)
+{
+    if (!presentSlots.contains(slot))
+    {
+        return setValue(slot, std::move(vals));
+    }
+
+    // append to the values that were already provided
 #ifdef CHAIN_CLI_VERBOSE
-    std::cout << "Appending positional argument: " << argName << "\n";
+    std::cout << "  Appending to existing repeatable argument in slot: " << slot << "\n";
 #endif
-    positionalArgs->try_emplace(argName, val);
+    auto &existing = std::any_cast<std::pmr::vector<std::any> &>(values[slot]);
+    existing.insert(existing.end(), std::make_move_iterator(vals.begin()),
+                    std::make_move_iterator(vals.end()));
     return *this;
 }
 
-inline_t ContextBuilder &ContextBuilder::addPositionalArgument(std::string_view argName, std::any &val)
+inline_t ContextBuilder &ContextBuilder::setFlag(size_t slot)
 {
-    return addPositionalArgument(std::string(argName), val);
+    presentSlots.insert(slot);
+    return *this;
 }
 
-inline_t ContextBuilder &ContextBuilder::addRepeatablePositionalArgument(const std::string &argName, const std::vector<std::any> &values)
+inline_t size_t ContextBuilder::slotFor(std::string_view argName, commands::ArgumentKind kind)
 {
-#ifdef CHAIN_CLI_VERBOSE
-    std::cout << "Adding repeatable positional argument to context: " << argName << " with " << values.size() << " values\n";
-#endif
-    if(!positionalArgs->contains(argName))
+    if (argumentIndex && !unboundIndex)
+    {
+        size_t slot = argumentIndex->findSlot(argName);
+        if (slot == commands::ArgumentIndex::npos)
+        {
+            throw std::invalid_argument(std::format(
+                "{} is not an argument of the command the context is built for", argName));
+        }
+        return slot;
+    }
+
+    // not bound to a command, every new name gets the next slot
+    if (!unboundIndex)
     {
-        positionalArgs->try_emplace(argName, values);
+        unboundIndex = std::make_shared<commands::ArgumentIndex>();
+        argumentIndex = unboundIndex.get();
     }
-    else 
+    if (const auto *entry = unboundIndex->find(argName))
     {
-        // If the argument already exists, we need to append the new values to the existing ones
+        if (entry->kind != kind)
+        {
+            throw std::invalid_argument(
+                std::format("{} was already added as another kind of argument", argName));
+        }
+        return entry->slot;
+    }
+    size_t slot = unboundIndex->addUnboundName(argName, kind);
+    values.resize(unboundIndex->slotCount());
+    presentSlots.resize(unboundIndex->slotCount());
+    return slot;
+}
+
+inline_t ContextBuilder &ContextBuilder::addPositionalArgument(const std::string &argName, std::any &val)
+{
+    return addPositionalArgument(std::string_view(argName), val);
+}
+
+inline_t ContextBuilder &ContextBuilder::addPositionalArgument(std::string_view argName, std::any &val)
+{
 #ifdef CHAIN_CLI_VERBOSE
-        std::cout << "Adding to existing repeatable positional argument: " << argName << "\n";
+    std::cout << "Appending positional argument: " << argName << "\n";
 #endif
-        std::any &existingValues = positionalArgs->at(argName);
-        std::vector<std::any> &vec = std::any_cast<std::vector<std::any> &>(existingValues);
-        vec.insert(vec.end(), values.begin(), values.end());
+    if (size_t slot = slotFor(argName, commands::ArgumentKind::Positional);
+        !presentSlots.contains(slot))
+    {
+        setValue(slot, val);
     }
     return *this;
 }
 
-inline_t ContextBuilder &ContextBuilder::addRepeatablePositionalArgument(std::string_view argName, const std::vector<std::any> &values)
+inline_t ContextBuilder &ContextBuilder::addRepeatablePositionalArgument(const std::string &argName, const std::vector<std::any> &values)
 {
-    return addRepeatablePositionalArgument(std::string(argName), values);
+    return addRepeatablePositionalArgument(std::string_view(argName), values);
 }
 
-inline_t ContextBuilder &ContextBuilder::addOptionArgument(const std::string &argName, std::any &val)
+inline_t ContextBuilder &ContextBuilder::addRepeatablePositionalArgument(std::string_view argName, const std::vector<std::any> &values)
 {
 #ifdef CHAIN_CLI_VERBOSE
-    std::cout << "Adding option argument: " << argName << "\n";
+    std::cout << "Adding repeatable positional argument to context: " << argName << " with " << values.size() << " values\n";
 #endif
-    optionalArgs->try_emplace(argName, val);
-    return *this;
+    return appendValues(slotFor(argName, commands::ArgumentKind::Positional),
+                        std::pmr::vector<std::any>(values.begin(), values.end(),
+                                                   getMemoryResource()));
 }
 
-inline_t ContextBuilder &ContextBuilder::addOptionArgument(std::string_view argName, std::any &val)
+inline_t ContextBuilder &ContextBuilder::addOptionArgument(const std::string &argName, std::any &val)
 {
-    return addOptionArgument(std::string(argName), val);
+    return addOptionArgument(std::string_view(argName), val);
 }
 
-inline_t ContextBuilder &ContextBuilder::addRepeatableOptionArgument(const std::string &argName, const std::vector<std::any> &values)
+inline_t ContextBuilder &ContextBuilder::addOptionArgument(std::string_view argName, std::any &val)
 {
 #ifdef CHAIN_CLI_VERBOSE
-    std::cout << "Adding to repeatable option argument to context: " << argName << " with " << values.size() << " values\n";
+    std::cout << "Adding option argument: " << argName << "\n";
 #endif
-    if(!optionalArgs->contains(argName))
-    {
-        optionalArgs->try_emplace(argName, values);
-    }
-    else
+    if (size_t slot = slotFor(argName, commands::ArgumentKind::Option);
+        !presentSlots.contains(slot))
     {
-        //append to existing values if already provided
-#ifdef CHAIN_CLI_VERBOSE
-        std::cout << "  Appending to existing repeatable option argument: " << argName << "\n";
-#endif
-        std::any &existingValues = optionalArgs->at(argName);
-        std::vector<std::any> &vec = std::any_cast<std::vector<std::any> &>(existingValues);
-        vec.insert(vec.end(), values.begin(), values.end());
+        setValue(slot, val);
     }
     return *this;
 }
 
-inline_t ContextBuilder &ContextBuilder::addRepeatableOptionArgument(std::string_view argName, const std::vector<std::any> &values)
+inline_t ContextBuilder &ContextBuilder::addRepeatableOptionArgument(const std::string &argName, const std::vector<std::any> &values)
 {
-    return addRepeatableOptionArgument(std::string(argName), values);
+    return addRepeatableOptionArgument(std::string_view(argName), values);
 }
 
-inline_t ContextBuilder &ContextBuilder::addFlagArgument(const std::string &argName)
+inline_t ContextBuilder &ContextBuilder::addRepeatableOptionArgument(std::string_view argName, const std::vector<std::any> &values)
 {
 #ifdef CHAIN_CLI_VERBOSE
-    std::cout << "Adding flag argument: " << argName << "\n";
+    std::cout << "Adding to repeatable option argument to context: " << argName << " with " << values.size() << " values\n";
 #endif
-    flagArgs->insert(argName);
-    return *this;
+    return appendValues(slotFor(argName, commands::ArgumentKind::Option),
+                        std::pmr::vector<std::any>(values.begin(), values.end(),
+                                                   getMemoryResource()));
+}
+
+inline_t ContextBuilder &ContextBuilder::addFlagArgument(const std::string &argName)
+{
+    return addFlagArgument(std::string_view(argName));
 }
 
 inline_t ContextBuilder &ContextBuilder::addFlagArgument(std::string_view argName)
 {
-    flagArgs->insert(std::string(argName));
-    return *this;
+#ifdef CHAIN_CLI_VERBOSE
+    std::cout << "Adding flag argument: " << argName << "\n";
+#endif
+    return setFlag(slotFor(argName, commands::ArgumentKind::Flag));
 }
 
 inline_t bool ContextBuilder::isArgPresent(const std::string &argName) const
 {
-    return optionalArgs->contains(argName) || flagArgs->contains(argName) ||
-           positionalArgs->contains(argName);
+    return argumentIndex && presentSlots.contains(argumentIndex->findSlot(argName));
 }
 
 inline_t std::unique_ptr<CliContext> ContextBuilder::build(cli::logging::AbstractLogger &logger)
 {
 #ifdef CHAIN_CLI_VERBOSE
-    std::cout << "Building CliContext with " << positionalArgs->size() << " positional, " 
-              << optionalArgs->size() << " option, and " << flagArgs->size() << " flag arguments\n";
+    std::cout << "Building CliContext with " << presentSlots.count() << " of " << values.size()
+              << " arguments present\n";
 #endif
-    return std::make_unique<CliContext>(std::move(positionalArgs), std::move(optionalArgs),
-                                        std::move(flagArgs), logger);
+    auto context = unboundIndex
+                       ? std::make_unique<CliContext>(
+                             std::shared_ptr<const commands::ArgumentIndex>(unboundIndex),
+                             std::move(values), std::move(presentSlots), logger)
+                       : std::make_unique<CliContext>(argumentIndex, std::move(values),
+                                                      std::move(presentSlots), logger);
+    reset();
+    return context;
+}
+
+inline_t CliContext ContextBuilder::buildContext(cli::logging::AbstractLogger &logger)
+{
+#ifdef CHAIN_CLI_VERBOSE
+    std::cout << "Building CliContext in place with " << presentSlots.count() << " of "
+              << values.size() << " arguments present\n";
+#endif
+    if (unboundIndex)
+    {
+        CliContext context(std::shared_ptr<const commands::ArgumentIndex>(unboundIndex),
+                           std::move(values), std::move(presentSlots), logger);
+        reset();
+        return context;
+    }
+    CliContext context(argumentIndex, std::move(values), std::move(presentSlots), logger);
+    reset();
+    return context;
+}
+
+inline_t void ContextBuilder::reset()
+{
+    argumentIndex = nullptr;
+    unboundIndex.reset();
+    values.clear();
+    presentSlots = commands::SlotSet(0, getMemoryResource());
 }
-} // namespace cli
\ No newline at end of file
+} // namespace cli
@@ -17,11 +17,14 @@
 #pragma once
 #include <any>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <string_view>
-#include <unordered_map>
+#include <vector>
 
 #include "cli_context.h"
+#include "commands/argument_index.h"
+#include "commands/slot_set.h"
 #include "logging/logger.h"
 
 namespace cli
@@ -29,11 +32,72 @@ namespace cli
 
 /// @brief Builder for CliContext objects, allowing to incrementally add arguments before
 /// constructing the final context object.
+/// @details Values are stored by the slot of their argument in the argument index of the command
+/// being parsed, the name based methods resolve the name to that slot first. A builder that is not
+/// bound to a command accepts any name instead: every new name gets the next slot in an index owned
+/// by the builder and later by the built context.
+/// All storage of the builder and of the contexts built from it (except the payloads of std::any
+/// values that don't fit its small buffer) is allocated from the memory resource of the builder,
+/// e.g. a per invocation arena.
 class ContextBuilder
 {
 public:
-    /// @brief Constructs a new ContextBuilder instance.
-    ContextBuilder();
+    /// @brief Constructs a new ContextBuilder instance that is not bound to a command yet.
+    /// @param resource the memory resource to allocate the storage from
+    explicit ContextBuilder(
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    /// @brief Constructs a new ContextBuilder instance for the arguments of a command.
+    /// @param argumentIndex the argument index of the command whose values will be added
+    /// @param resource the memory resource to allocate the storage from
+    explicit ContextBuilder(
+        const commands::ArgumentIndex &argumentIndex,
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    /// @brief Gets the memory resource the storage of the builder is allocated from.
+    /// @return the memory resource of the builder
+    [[nodiscard]] std::pmr::memory_resource *getMemoryResource() const noexcept
+    {
+        return values.get_allocator().resource();
+    }
+
+    /// @brief Binds the builder to the arguments of a command, sizing the value storage.
+    /// @note Binding to the index the builder is already bound to keeps the added values, any other
+    /// binding discards them (including values added by name while the builder was unbound).
+    /// @param argumentIndex the argument index of the command whose values will be added
+    void bind(const commands::ArgumentIndex &argumentIndex);
+
+    /// @brief Set the value of the argument in the given slot.
+    /// @param slot the slot of the argument
+    /// @param val value of the argument
+    /// @return a reference to this ContextBuilder instance
+    ContextBuilder &setValue(size_t slot, std::any val);
+
+    /// @brief Append values to the repeatable argument in the given slot.
+    /// @param slot the slot of the repeatable argument
+    /// @param vals values to append
+    /// @return a reference to this ContextBuilder instance
+    ContextBuilder &appendValues(size_t slot, std::pmr::vector<std::any> vals);
+
+    /// @brief Mark the flag in the given slot as present.
+    /// @param slot the slot of the flag argument
+    /// @return a reference to this ContextBuilder instance
+    ContextBuilder &setFlag(size_t slot);
+
+    /// @brief Checks if the argument in the given slot is present in the context being built.
+    /// @param slot the slot of the argument
+    /// @return true if the argument is present, false otherwise
+    [[nodiscard]] bool isSlotPresent(size_t slot) const noexcept
+    {
+        return presentSlots.contains(slot);
+    }
+
+    /// @brief Get the slots of all arguments present in the context being built.
+    /// @return the set of present slots
+    [[nodiscard]] const commands::SlotSet &getPresentSlots() const noexcept
+    {
+        return presentSlots;
+    }
 
     /// @brief Add a positional argument to the context being built.
     /// @param argName the name of the positional argument
@@ -104,10 +168,25 @@ public:
     /// @return a unique_ptr to the created CliContext object
     std::unique_ptr<CliContext> build(cli::logging::AbstractLogger &logger);
 
+    /// @brief Builds the final CliContext object from the accumulated arguments in place, without
+    /// allocating it separately.
+    /// @param logger the logger instance to use in the created context
+    /// @return the created CliContext object
+    CliContext buildContext(cli::logging::AbstractLogger &logger);
+
 private:
-    std::unique_ptr<std::unordered_map<std::string, std::any>> positionalArgs;
-    std::unique_ptr<std::unordered_map<std::string, std::any>> optionalArgs;
-    std::unique_ptr<std::unordered_set<std::string>> flagArgs;
+    // slot of the argument with the given name, throws if the bound command has none or the name
+    // was added to an unbound builder as another kind; adds a new slot for new names if unbound
+    size_t slotFor(std::string_view argName, commands::ArgumentKind kind);
+
+    // unbinds the builder after its values were moved into a context
+    void reset();
+
+    const commands::ArgumentIndex *argumentIndex{nullptr};
+    // index of the names added while not bound to a command, argumentIndex points to it if set
+    std::shared_ptr<commands::ArgumentIndex> unboundIndex;
+    std::pmr::vector<std::any> values;
+    commands::SlotSet presentSlots;
 };
 
-} // namespace cli
\ No newline at end of file
+} // namespace cli
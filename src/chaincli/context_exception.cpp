@@ -14,6 +14,7 @@
 
 #include "context_exception.h"
 #include <sstream>
+#include <vector>
 
 #define inline_t
 
@@ -21,18 +22,30 @@ namespace cli
 {
     inline_t std::string MissingArgumentException::makeMessage(
     const std::string &name, const std::unordered_map<std::string, std::any> &args)
+{
+    std::vector<std::string_view> available;
+    available.reserve(args.size());
+    for (auto &[k, _] : args)
+    {
+        available.emplace_back(k);
+    }
+    return makeMessage(name, available);
+}
+
+inline_t std::string MissingArgumentException::makeMessage(
+    std::string_view name, std::span<const std::string_view> available)
 {
     std::ostringstream oss;
     oss << "Missing argument: \"" << name << "\" was not passed in this context.\n";
     oss << "Available arguments: ";
-    if (args.empty())
+    if (available.empty())
     {
         oss << "<none>";
     }
     else
     {
         bool first = true;
-        for (auto &[k, _] : args)
+        for (auto k : available)
         {
             if (!first)
                 oss << ", ";
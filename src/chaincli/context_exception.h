@@ -15,10 +15,12 @@
  */
 
 #pragma once
+#include <any>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
-#include <any>
 
 namespace cli
 {
@@ -32,9 +34,16 @@ public:
     {
     }
 
+    MissingArgumentException(std::string_view name, std::span<const std::string_view> available)
+        : std::runtime_error(makeMessage(name, available))
+    {
+    }
+
 private:
     static std::string makeMessage(const std::string &name,
                                    const std::unordered_map<std::string, std::any> &args);
+    static std::string makeMessage(std::string_view name,
+                                   std::span<const std::string_view> available);
 };
 
 /// @brief Thrown when an argument type that was requested is not the one that was parsed.
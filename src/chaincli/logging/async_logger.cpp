@@ -0,0 +1,187 @@
+// Copyright 2025 Dominik Czekai
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "async_logger.h"
+
+#include <optional>
+#include <utility>
+
+#define inline_t
+
+namespace cli::logging
+{
+inline_t AsyncLogger::AsyncLogger(LogLevel lvl, size_t capacity, OverflowPolicy policy)
+    : overflowPolicy(policy), queue(capacity),
+      streams([this](LogLevel level, const std::string &msg) { this->log(level, msg); }, lvl)
+{
+    setEnabledLevel(lvl);
+
+    // add default console handler
+    addHandler(std::make_unique<ConsoleHandler>(std::make_shared<MessageOnlyFormatter>(),
+                                                LogLevel::TRACE));
+
+    writer = std::jthread([this] { writerLoop(); });
+}
+
+inline_t AsyncLogger::~AsyncLogger()
+{
+    stopping.store(true, std::memory_order_release);
+    wakeWriter();
+    if (writer.joinable())
+    {
+        writer.join(); // the writer emits the remaining records before it returns
+    }
+}
+
+inline_t void AsyncLogger::setLevel(LogLevel lvl)
+{
+    setEnabledLevel(lvl);
+    streams.setMinLevel(lvl);
+}
+
+inline_t void AsyncLogger::addHandler(std::unique_ptr<AbstractHandler> handlerPtr)
+{
+    std::scoped_lock lock(handlersMutex);
+    handlers.push_back(std::move(handlerPtr));
+}
+
+inline_t void AsyncLogger::removeAllHandlers()
+{
+    std::scoped_lock lock(handlersMutex);
+    handlers.clear();
+}
+
+inline_t void AsyncLogger::log(LogLevel lvl, const std::string &msg) const
+{
+    if (!isEnabled(lvl))
+        return; // ignore messages below minimum level
+
+    enqueue(PendingRecord{lvl, msg, {}, std::chrono::system_clock::now()});
+}
+
+inline_t void AsyncLogger::logDeferred(LogLevel lvl, DeferredMessage message) const
+{
+    if (!isEnabled(lvl))
+        return; // ignore messages below minimum level
+
+    enqueue(PendingRecord{lvl, {}, std::move(message), std::chrono::system_clock::now()});
+}
+
+inline_t void AsyncLogger::enqueue(PendingRecord &&pending) const
+{
+    while (!queue.tryPush(std::move(pending)))
+    {
+        switch (overflowPolicy)
+        {
+        case OverflowPolicy::DropNewest:
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        case OverflowPolicy::DropOldest:
+            if (queue.tryConsume([](const PendingRecord &) {}))
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                // an evicted record counts as done for flush()
+                completed.fetch_add(1, std::memory_order_release);
+                completed.notify_all();
+            }
+            break;
+        case OverflowPolicy::Block:
+            wakeWriter();
+            std::this_thread::yield();
+            break;
+        }
+    }
+    wakeWriter();
+}
+
+inline_t std::ostream &AsyncLogger::getStream(LogLevel lvl)
+{
+    return streams.get(lvl);
+}
+
+inline_t void AsyncLogger::flush()
+{
+    const uint64_t target = queue.pushedCount();
+    wakeWriter();
+
+    uint64_t done = completed.load(std::memory_order_acquire);
+    while (done < target)
+    {
+        completed.wait(done, std::memory_order_acquire);
+        done = completed.load(std::memory_order_acquire);
+    }
+}
+
+inline_t void AsyncLogger::wakeWriter() const
+{
+    wakeups.fetch_add(1, std::memory_order_release);
+    wakeups.notify_one();
+}
+
+inline_t void AsyncLogger::writerLoop()
+{
+    while (true)
+    {
+        // read before draining, so a record queued after the drain changes it and ends the wait
+        const uint64_t seen = wakeups.load(std::memory_order_acquire);
+
+        if (const size_t emitted = emitQueued(); emitted > 0)
+        {
+            completed.fetch_add(emitted, std::memory_order_release);
+            completed.notify_all();
+            continue;
+        }
+        if (stopping.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        wakeups.wait(seen, std::memory_order_acquire);
+    }
+}
+
+inline_t size_t AsyncLogger::emitQueued()
+{
+    std::scoped_lock lock(handlersMutex);
+
+    // at most one queue length per batch, so flush() and handler changes don't wait for a queue
+    // that is refilled as fast as it is drained
+    size_t emitted = 0;
+    std::optional<PendingRecord> pending;
+    const auto takePending = [&pending](PendingRecord &queued) {
+        pending.emplace(std::move(queued));
+    };
+    while (emitted < queue.capacity() && queue.tryConsume(takePending))
+    {
+        ++emitted;
+        try
+        {
+            const LogRecord record(pending->level,
+                                   pending->deferred ? pending->deferred.format()
+                                                     : std::move(pending->message),
+                                   pending->timestamp);
+            for (auto const &handler : handlers)
+            {
+                handler->emit(record);
+            }
+        }
+        catch (const std::exception &)
+        {
+            // there is no caller to report to, a failing formatter or handler must not stop the
+            // writer
+        }
+    }
+    return emitted;
+}
+
+} // namespace cli::logging
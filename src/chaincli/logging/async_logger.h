@@ -0,0 +1,138 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "logger.h"
+#include "ring_buffer.h"
+
+namespace cli::logging
+{
+
+/// @brief What an AsyncLogger does with a message when its queue is full.
+enum class OverflowPolicy
+{
+    Block,      // wait until the writer thread made room
+    DropNewest, // discard the message that is logged
+    DropOldest, // discard the oldest queued message to make room
+};
+
+/// @brief Logger that hands the records to a background thread which passes them to the handlers.
+/// @details Logging only creates the record and pushes it into a bounded lock-free queue, so the
+/// calling thread never waits for the console or a file (unless the queue is full and the policy
+/// is OverflowPolicy::Block). The records reach the handlers in the order they were queued.
+/// Call flush() where the output has to be complete, e.g. before writing to std::cout directly,
+/// the destructor emits all remaining records before it returns.
+/// @note Handlers are only called from the writer thread, they should not log to this logger.
+class AsyncLogger : public AbstractLogger
+{
+public:
+    /// @brief Construct a new AsyncLogger and start its writer thread.
+    /// @param lvl The minimum log level for this logger
+    /// @param capacity The number of records the queue can hold, rounded up to a power of two
+    /// @param policy What to do with messages logged while the queue is full
+    explicit AsyncLogger(LogLevel lvl = LogLevel::TRACE, size_t capacity = 8192,
+                         OverflowPolicy policy = OverflowPolicy::Block);
+
+    /// @brief Emit all queued records and stop the writer thread.
+    ~AsyncLogger() override;
+
+    AsyncLogger(const AsyncLogger &) = delete;
+    AsyncLogger &operator=(const AsyncLogger &) = delete;
+    AsyncLogger(AsyncLogger &&) = delete;
+    AsyncLogger &operator=(AsyncLogger &&) = delete;
+
+    void setLevel(LogLevel lvl) override;
+
+    /// @brief Add a log handler, waits until the writer thread finished its current batch.
+    /// @param handlerPtr The log handler to add
+    void addHandler(std::unique_ptr<AbstractHandler> handlerPtr) override;
+
+    /// @brief Remove all log handlers, waits until the writer thread finished its current batch.
+    void removeAllHandlers() override;
+
+    using AbstractLogger::log;
+    using AbstractLogger::logDeferred;
+
+    /// @brief Queue a message for the writer thread.
+    /// @param lvl The log level
+    /// @param msg The message to log
+    void log(LogLevel lvl, const std::string &msg) const override;
+
+    /// @brief Queue a message that the writer thread formats before it passes it to the handlers.
+    /// @param lvl The log level
+    /// @param message The message to format and log
+    void logDeferred(LogLevel lvl, DeferredMessage message) const override;
+
+    std::ostream &getStream(LogLevel lvl) override;
+
+    /// @brief Block until all messages queued before the call were passed to the handlers (or
+    /// dropped).
+    void flush() override;
+
+    /// @brief Get the number of messages dropped because the queue was full.
+    /// @return The number of dropped messages since construction.
+    [[nodiscard]] uint64_t droppedCount() const noexcept
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    void wakeWriter() const;
+    void writerLoop();
+    size_t emitQueued();
+
+    // a queued message, moved out of the queue before it is emitted so its slot is free again
+    // while the handlers write
+    struct PendingRecord
+    {
+        LogLevel level;
+        std::string message;
+        DeferredMessage deferred; // formatted into message on the writer thread if set
+        std::chrono::system_clock::time_point timestamp;
+    };
+
+    void enqueue(PendingRecord &&pending) const;
+
+    const OverflowPolicy overflowPolicy;
+    mutable RingBuffer<PendingRecord> queue;
+
+    // records emitted or evicted, flush() waits until it reaches the number of queued records
+    mutable std::atomic<uint64_t> completed{0};
+    mutable std::atomic<uint64_t> dropped{0};
+    // bumped on every new record, the writer thread waits on it while the queue is empty
+    mutable std::atomic<uint64_t> wakeups{0};
+    std::atomic<bool> stopping{false};
+
+    // only guards against changes of the handlers while the writer thread emits, never taken by
+    // logging threads
+    std::mutex handlersMutex;
+    std::vector<std::unique_ptr<AbstractHandler>> handlers;
+
+    // Per-level streams, separate for every thread
+    LogStreams streams;
+
+    // started last, after everything it uses is constructed
+    std::jthread writer;
+};
+} // namespace cli::logging
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <format>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace cli::logging
+{
+
+/// @brief Type a format argument is stored as in a DeferredMessage: character pointers and string
+/// views are copied into a std::string, since the message may be formatted after the caller
+/// returned, all other types are stored by value.
+template <typename T>
+using DeferredArgument =
+    std::conditional_t<std::is_convertible_v<std::decay_t<T>, std::string_view> &&
+                           !std::is_same_v<std::decay_t<T>, std::string>,
+                       std::string, std::decay_t<T>>;
+
+/// @brief A format string with copies of its arguments, formatted only when the message is needed.
+/// @details Lets a logger move the formatting out of the logging thread, e.g. the AsyncLogger
+/// formats on its writer thread. The format string is checked against the arguments at compile
+/// time when the message is created.
+class DeferredMessage
+{
+public:
+    DeferredMessage() = default;
+
+    /// @brief Capture a format string and copies of its arguments.
+    /// @tparam ...Args The argument types for the format string
+    /// @param fmt The format string, has to outlive the message (e.g. a string literal)
+    /// @param ...args The arguments for the format string
+    template <typename... Args>
+    explicit DeferredMessage(std::format_string<Args...> fmt, Args &&...args)
+        : formatFunc([fmt = fmt.get(),
+                      ... captured = DeferredArgument<Args>(std::forward<Args>(args))]() {
+              return std::vformat(fmt, std::make_format_args(captured...));
+          })
+    {
+    }
+
+    /// @brief Format the message.
+    /// @return The formatted message, empty for a default constructed message.
+    [[nodiscard]] std::string format() const { return formatFunc ? formatFunc() : std::string(); }
+
+    /// @brief Check if the message holds a format string.
+    explicit operator bool() const noexcept { return static_cast<bool>(formatFunc); }
+
+private:
+    std::function<std::string()> formatFunc;
+};
+
+} // namespace cli::logging
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <ios>
+#include <ostream>
+#include <type_traits>
+
+#include "loglevel.h"
+
+namespace cli::logging
+{
+
+/// @brief Stand-in for the stream of a log level that is removed at compile time (see
+/// CHAIN_CLI_MIN_LOG_LEVEL). Everything written to it is discarded without being formatted, so
+/// the optimizer removes the whole statement.
+class DisabledStream
+{
+public:
+    using StreamManipulator = std::ostream &(*)(std::ostream &);
+    using FormatManipulator = std::ios_base &(*)(std::ios_base &);
+
+    /// @brief Discard a value.
+    /// @tparam T The type of the value
+    /// @return This stream, to chain further discarded values
+    template <typename T> const DisabledStream &operator<<(const T & /*value*/) const noexcept
+    {
+        return *this;
+    }
+
+    /// @brief Discard a stream manipulator like std::flush or std::endl.
+    /// @return This stream, to chain further discarded values
+    const DisabledStream &operator<<(StreamManipulator /*manipulator*/) const noexcept
+    {
+        return *this;
+    }
+
+    /// @brief Discard a format manipulator like std::hex.
+    /// @return This stream, to chain further discarded values
+    const DisabledStream &operator<<(FormatManipulator /*manipulator*/) const noexcept
+    {
+        return *this;
+    }
+};
+
+/// @brief The stream type the stream shortcuts of a logger return for a log level.
+/// @tparam Level The log level
+template <LogLevel Level>
+using LevelStream = std::conditional_t<isCompiledIn(Level), std::ostream &, DisabledStream>;
+
+} // namespace cli::logging
@@ -40,6 +40,7 @@ inline_t void BaseHandler::emit(const LogRecord &record) const
         }
     }
 
+    std::scoped_lock lock(writeMutex);
     if (record.level >= LogLevel::ERROR)
     {
         err << formatted;
@@ -18,6 +18,7 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 
 #include "formatter.h"
 #include "logstyle.h"
@@ -74,6 +75,8 @@ private:
     std::shared_ptr<AbstractFormatter> formatterPtr;
     std::shared_ptr<const LogStyleMap> styleMapPtr;
     LogLevel minLevel;
+    // keeps the messages of concurrent emits from interleaving, only held for the final write
+    mutable std::mutex writeMutex;
 };
 
 /// @brief Console log handler.
@@ -14,20 +14,139 @@
 
 #include "log_streambuffer.h"
 
+#include <stdexcept>
+#include <utility>
+
 #define inline_t
 
 namespace cli::logging
 {
+inline_t LogStreamBuf::LogStreamBuf(
+    std::shared_ptr<std::function<void(LogLevel, const std::string &)>> logFuncPtr, LogLevel lvl,
+    LogLevel lvlMin)
+    : logFuncPtr(std::move(logFuncPtr)), lvl(lvl), minLevel(lvlMin)
+{
+    resetPutArea();
+}
+
+inline_t void LogStreamBuf::setMinLevel(LogLevel lvlMin)
+{
+    if (lvlMin == minLevel)
+        return;
+
+    const bool wasEnabled = isEnabled();
+    minLevel = lvlMin;
+    if (wasEnabled != isEnabled())
+    {
+        spill.clear();
+        resetPutArea();
+    }
+}
+
 inline_t int LogStreamBuf::sync()
 {
-    if (lvl < minLevel)
+    if (!isEnabled())
         return 0; // skip
 
-    if (auto msg = str(); !msg.empty())
+    if (pptr() != pbase() || !spill.empty())
     {
-        (*logFuncPtr)(lvl, msg); // call the function
-        str("");                 // clear the buffer
+        spill.append(pbase(), pptr());
+        (*logFuncPtr)(lvl, spill); // call the function
+        spill.clear();             // keeps the capacity for the next long message
+        resetPutArea();
     }
     return 0;
 }
+
+inline_t LogStreamBuf::int_type LogStreamBuf::overflow(int_type ch)
+{
+    if (!isEnabled())
+        return traits_type::not_eof(ch); // discard
+
+    // the fixed buffer is full, move its contents to the heap and reuse it
+    spill.append(pbase(), pptr());
+    resetPutArea();
+    if (!traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+inline_t std::streamsize LogStreamBuf::xsputn(const char_type *s, std::streamsize count)
+{
+    if (!isEnabled())
+        return count; // discard
+
+    if (count > epptr() - pptr())
+    {
+        // does not fit into the rest of the fixed buffer, append both to the heap
+        spill.append(pbase(), pptr());
+        spill.append(s, static_cast<size_t>(count));
+        resetPutArea();
+        return count;
+    }
+    traits_type::copy(pptr(), s, static_cast<size_t>(count));
+    pbump(static_cast<int>(count));
+    return count;
+}
+
+inline_t void LogStreamBuf::resetPutArea()
+{
+    if (isEnabled())
+    {
+        setp(inlineBuffer.data(), inlineBuffer.data() + inlineBuffer.size());
+    }
+    else
+    {
+        setp(nullptr, nullptr); // every write goes to overflow or xsputn, which discard it
+    }
+}
+
+inline_t LogStreams::LogStreams(LogFunction logFunc, LogLevel lvlMin)
+    : shared(std::make_shared<Shared>(std::make_shared<LogFunction>(std::move(logFunc)), lvlMin)),
+      id(nextId())
+{
+}
+
+inline_t std::ostream &LogStreams::get(LogLevel lvl)
+{
+    const auto index = static_cast<size_t>(lvl);
+    if (index >= levelCount)
+    {
+        throw std::invalid_argument("Invalid log level for stream");
+    }
+
+    auto &perThread = threadStreams();
+    auto it = perThread.find(id);
+    if (it == perThread.end())
+    {
+        // first use in this thread, drop the buffers of destroyed instances
+        std::erase_if(perThread, [](const auto &entry) { return entry.second.owner.expired(); });
+        it = perThread.try_emplace(id).first;
+        it->second.owner = shared;
+    }
+
+    auto &streams = it->second;
+    if (!streams.buffers[index])
+    {
+        streams.buffers[index] = std::make_unique<LogStreamBuf>(shared->logFuncPtr, lvl, lvl);
+        streams.streams[index] = std::make_unique<std::ostream>(streams.buffers[index].get());
+    }
+    streams.buffers[index]->setMinLevel(shared->minLevel.load(std::memory_order_relaxed));
+    return *streams.streams[index];
+}
+
+inline_t std::unordered_map<uint64_t, LogStreams::ThreadStreams> &LogStreams::threadStreams()
+{
+    thread_local std::unordered_map<uint64_t, ThreadStreams> perThread;
+    return perThread;
+}
+
+inline_t uint64_t LogStreams::nextId()
+{
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
 } // namespace cli::logging
@@ -13,39 +13,117 @@
 // limitations under the License.
 
 #pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <sstream>
+#include <ostream>
+#include <streambuf>
 #include <functional>
+#include <unordered_map>
 #include "logging/loglevel.h"
 
 namespace cli::logging
 {
 /// @brief Log stream buffer with a minimum LogLevel, that redirects the buffered output to a
 /// logging function. Used to offer own streams to write to for each log level.
+/// @details Messages are written into a fixed buffer that is reused for every message, only
+/// messages longer than the buffer spill into a heap string. While the level is below the minimum
+/// level the buffer has no put area and everything written to it is discarded without copying.
 /// @note Does not flush automatically on newline, call sync() or explicitly flush buffer.
-class LogStreamBuf : public std::stringbuf
+class LogStreamBuf : public std::streambuf
 {
 public:
+    /// @brief Number of characters a message can have before it spills to the heap.
+    static constexpr size_t inlineCapacity = 256;
+
     /// @brief Construct a new LogStreamBuf
     /// @param logFuncPtr The logging function to call with the buffered output
     /// @param lvl The log level for this buffer
     /// @param lvlMin The minimum log level for this buffer
     explicit LogStreamBuf(std::shared_ptr<std::function<void(LogLevel, const std::string &)>> logFuncPtr,
-                 LogLevel lvl, LogLevel lvlMin)
-        : logFuncPtr(logFuncPtr), lvl(lvl), minLevel(lvlMin)
-    {
-    }
+                 LogLevel lvl, LogLevel lvlMin);
 
-    int sync() override;
+    LogStreamBuf(const LogStreamBuf &) = delete;
+    LogStreamBuf &operator=(const LogStreamBuf &) = delete;
 
-    /// @brief Set the minimum log level for this buffer
+    /// @brief Set the minimum log level for this buffer, a pending message is discarded if the
+    /// level of the buffer is disabled by it.
     /// @param lvlMin The new minimum log level
-    void setMinLevel(LogLevel lvlMin) { minLevel = lvlMin; }
+    void setMinLevel(LogLevel lvlMin);
+
+protected:
+    int sync() override;
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char_type *s, std::streamsize count) override;
 
 private:
+    [[nodiscard]] bool isEnabled() const { return lvl >= minLevel; }
+    void resetPutArea();
+
     std::shared_ptr<std::function<void(LogLevel, const std::string &)>> logFuncPtr;
     LogLevel lvl;
     LogLevel minLevel;
+    std::array<char, inlineCapacity> inlineBuffer{};
+    std::string spill; // start of a message that did not fit into inlineBuffer
+};
+
+/// @brief The per-level output streams of a logger, with separate buffers for every thread.
+/// @details Each thread writing to a stream gets its own LogStreamBuf and std::ostream per level,
+/// created on its first use, so threads never share a buffer and no lock is needed while a
+/// message is built. A flush hands the complete message of the calling thread to the logging
+/// function in one call.
+class LogStreams
+{
+public:
+    /// @brief Function the buffered messages are passed to.
+    using LogFunction = std::function<void(LogLevel, const std::string &)>;
+
+    /// @brief Construct the streams of a logger.
+    /// @param logFunc The logging function to call with the buffered output
+    /// @param lvlMin The minimum log level of the streams
+    LogStreams(LogFunction logFunc, LogLevel lvlMin);
+
+    LogStreams(const LogStreams &) = delete;
+    LogStreams &operator=(const LogStreams &) = delete;
+    LogStreams(LogStreams &&) noexcept = default;
+    LogStreams &operator=(LogStreams &&) noexcept = default;
+
+    /// @brief Get the stream of the calling thread for a log level.
+    /// @param lvl The log level
+    /// @return The output stream of the calling thread for the log level
+    std::ostream &get(LogLevel lvl);
+
+    /// @brief Set the minimum log level, used by every thread from its next call to get().
+    /// @param lvlMin The new minimum log level
+    void setMinLevel(LogLevel lvlMin) { shared->minLevel.store(lvlMin, std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t levelCount = static_cast<size_t>(LogLevel::ERROR) + 1;
+
+    // state shared with the buffers of all threads
+    struct Shared
+    {
+        std::shared_ptr<LogFunction> logFuncPtr;
+        std::atomic<LogLevel> minLevel;
+    };
+
+    // the buffers of one thread for one LogStreams instance
+    struct ThreadStreams
+    {
+        std::weak_ptr<Shared> owner; // expired once the LogStreams is destroyed
+        std::array<std::unique_ptr<LogStreamBuf>, levelCount> buffers;
+        std::array<std::unique_ptr<std::ostream>, levelCount> streams;
+    };
+
+    // the buffers of the calling thread for all LogStreams instances, by id. Buffers of destroyed
+    // instances are dropped by the next first use of an instance in the thread or when the thread
+    // exits, never by the destructor, which may run after the map of its thread was destroyed
+    static std::unordered_map<uint64_t, ThreadStreams> &threadStreams();
+    static uint64_t nextId();
+
+    std::shared_ptr<Shared> shared;
+    uint64_t id;
 };
 } // namespace cli::logging
@@ -20,18 +20,10 @@
 
 namespace cli::logging
 {
-inline_t Logger::Logger(LogLevel lvl) : minLevel(lvl)
+inline_t Logger::Logger(LogLevel lvl)
+    : streams([this](LogLevel level, const std::string &msg) { this->log(level, msg); }, lvl)
 {
-    // Wrap logInternal as a lambda and pass it to LogStreamBuf
-    auto logFuncPtr = std::make_shared<std::function<void(LogLevel, const std::string &)>>(
-        [this](LogLevel level, const std::string &msg) { this->log(level, msg); });
-
-    for (auto i = static_cast<int>(LogLevel::TRACE); i <= static_cast<int>(LogLevel::ERROR); ++i)
-    {
-        auto level = static_cast<LogLevel>(i);
-        buffers[level] = std::make_unique<LogStreamBuf>(logFuncPtr, level, minLevel);
-        streams[level] = std::make_unique<std::ostream>(buffers[level].get());
-    }
+    setEnabledLevel(lvl);
 
     // add default console handler
     addHandler(std::make_unique<ConsoleHandler>(std::make_shared<MessageOnlyFormatter>(), LogLevel::TRACE));
@@ -39,11 +31,8 @@ inline_t Logger::Logger(LogLevel lvl) : minLevel(lvl)
 
 inline_t void Logger::setLevel(LogLevel lvl)
 {
-    minLevel = lvl;
-    for (auto const &[level, buffer] : buffers)
-    {
-        buffer->setMinLevel(lvl);
-    }
+    setEnabledLevel(lvl);
+    streams.setMinLevel(lvl);
 }
 
 inline_t void Logger::addHandler(std::unique_ptr<AbstractHandler> handlerPtr)
@@ -53,7 +42,7 @@ inline_t void Logger::addHandler(std::unique_ptr<AbstractHandler> handlerPtr)
 
 inline_t void Logger::log(LogLevel lvl, const std::string &msg) const
 {
-    if(lvl < minLevel)
+    if (!isEnabled(lvl))
         return; // ignore messages below minimum level
     LogRecord record{lvl, msg};
 
@@ -65,11 +54,7 @@ inline_t void Logger::log(LogLevel lvl, const std::string &msg) const
 
 inline_t std::ostream &Logger::getStream(LogLevel lvl)
 {
-    if (auto it = streams.find(lvl); it != streams.end())
-    {
-        return *(it->second);
-    }
-    throw std::invalid_argument("Invalid log level for stream");
+    return streams.get(lvl);
 }
 
 } // namespace cli::logging
\ No newline at end of file
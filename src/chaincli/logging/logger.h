@@ -15,14 +15,46 @@
  */
 
 #pragma once
+#include <atomic>
+#include <format>
 #include <functional>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 
+#include "deferred_message.h"
+#include "disabled_stream.h"
 #include "handler.h"
 #include "log_streambuffer.h"
 
+/// @brief Log through an AbstractLogger without evaluating the message or the arguments if the
+/// level is removed at compile time (see CHAIN_CLI_MIN_LOG_LEVEL) or disabled at runtime, e.g.
+/// CHAIN_CLI_LOG(logger, LogLevel::DEBUG, "{}", expensive()). The level has to be a constant.
+#define CHAIN_CLI_LOG(logger, level, ...)                                                          \
+    do                                                                                             \
+    {                                                                                              \
+        if constexpr (::cli::logging::isCompiledIn(level))                                         \
+        {                                                                                          \
+            const ::cli::logging::AbstractLogger &chainCliLogger_ = (logger);                      \
+            if (chainCliLogger_.isEnabled(level))                                                  \
+                chainCliLogger_.log(level, __VA_ARGS__);                                           \
+        }                                                                                          \
+    } while (false)
+
+#define CHAIN_CLI_LOG_TRACE(logger, ...)                                                           \
+    CHAIN_CLI_LOG(logger, ::cli::logging::LogLevel::TRACE, __VA_ARGS__)
+#define CHAIN_CLI_LOG_VERBOSE(logger, ...)                                                         \
+    CHAIN_CLI_LOG(logger, ::cli::logging::LogLevel::VERBOSE, __VA_ARGS__)
+#define CHAIN_CLI_LOG_DEBUG(logger, ...)                                                           \
+    CHAIN_CLI_LOG(logger, ::cli::logging::LogLevel::DEBUG, __VA_ARGS__)
+#define CHAIN_CLI_LOG_SUCCESS(logger, ...)                                                         \
+    CHAIN_CLI_LOG(logger, ::cli::logging::LogLevel::SUCCESS, __VA_ARGS__)
+#define CHAIN_CLI_LOG_INFO(logger, ...)                                                            \
+    CHAIN_CLI_LOG(logger, ::cli::logging::LogLevel::INFO, __VA_ARGS__)
+#define CHAIN_CLI_LOG_WARNING(logger, ...)                                                         \
+    CHAIN_CLI_LOG(logger, ::cli::logging::LogLevel::WARNING, __VA_ARGS__)
+#define CHAIN_CLI_LOG_ERROR(logger, ...)                                                           \
+    CHAIN_CLI_LOG(logger, ::cli::logging::LogLevel::ERROR, __VA_ARGS__)
+
 namespace cli::logging
 {
 
@@ -30,8 +62,20 @@ namespace cli::logging
 class AbstractLogger
 {
 public:
+    AbstractLogger() = default;
     virtual ~AbstractLogger() = default;
 
+    AbstractLogger(const AbstractLogger &other) noexcept
+        : enabledLevel(other.enabledLevel.load(std::memory_order_relaxed))
+    {
+    }
+    AbstractLogger &operator=(const AbstractLogger &other) noexcept
+    {
+        enabledLevel.store(other.enabledLevel.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+        return *this;
+    }
+
     /// @brief Set the minimum log level for this logger.
     /// @param lvl The new minimum log level
     virtual void setLevel(LogLevel lvl) = 0;
@@ -53,79 +97,174 @@ public:
     /// @return The output stream for the specified log level
     virtual std::ostream &getStream(LogLevel lvl) = 0;
 
+    /// @brief Block until all messages logged so far were passed to the handlers. Loggers that
+    /// emit synchronously have nothing to wait for.
+    virtual void flush() {}
+
+    /// @brief Log a message that is only formatted when it is emitted. The default implementation
+    /// formats it right away, loggers that emit on another thread format it there.
+    /// @param lvl The log level
+    /// @param message The message to format and log
+    virtual void logDeferred(LogLevel lvl, DeferredMessage message) const
+    {
+        log(lvl, message.format());
+    }
+
+    /// @brief Check if messages of a log level are logged at all, without a virtual call.
+    /// @param lvl The log level
+    /// @return False if the level is below the minimum level of the logger or removed at compile
+    /// time (see CHAIN_CLI_MIN_LOG_LEVEL).
+    [[nodiscard]] bool isEnabled(LogLevel lvl) const noexcept
+    {
+        return isCompiledIn(lvl) && lvl >= enabledLevel.load(std::memory_order_relaxed);
+    }
+
     /// @brief Log a message at the specified log level using a format string to print the passed
-    /// arguments.
+    /// arguments. The format string is checked at compile time and nothing is formatted if the
+    /// level is disabled.
     /// @tparam ...Args The argument types for the format string
     /// @param lvl The log level for this message
     /// @param fmt The format string
     /// @param ...args The arguments for the format string
-    template <typename... Args> void log(LogLevel lvl, const std::string &fmt, Args &&...args) const
+    template <typename... Args>
+    void log(LogLevel lvl, std::format_string<Args...> fmt, Args &&...args) const
     {
-        std::string formatted = std::vformat(fmt, std::make_format_args(args...));
-        log(lvl, formatted);
+        if (!isEnabled(lvl))
+            return;
+        log(lvl, std::format(fmt, std::forward<Args>(args)...));
+    }
+
+    /// @brief Log a message using a format string, copying the arguments and leaving the
+    /// formatting to the logger (see DeferredMessage). Nothing is copied if the level is disabled.
+    /// @tparam ...Args The argument types for the format string
+    /// @param lvl The log level for this message
+    /// @param fmt The format string, has to outlive the logger (e.g. a string literal)
+    /// @param ...args The arguments for the format string
+    template <typename... Args>
+    void logDeferred(LogLevel lvl, std::format_string<Args...> fmt, Args &&...args) const
+    {
+        if (!isEnabled(lvl))
+            return;
+        logDeferred(lvl, DeferredMessage(fmt, std::forward<Args>(args)...));
     }
 
 #pragma region LogLevelShortcuts
 
     /// @brief Log a message at the TRACE level.
+    /// @param message The message to log
+    void trace(const std::string &message)
+    {
+        if (isEnabled(LogLevel::TRACE))
+            log(LogLevel::TRACE, message);
+    }
+
+    /// @brief Log a message at the TRACE level using a format string.
     /// @tparam ...Args The argument types for the format string
     /// @param fmt The format string
     /// @param ...args The arguments for the format string
-    template <typename... Args> void trace(const std::string &fmt, Args &&...args)
+    template <typename... Args> void trace(std::format_string<Args...> fmt, Args &&...args)
     {
         log(LogLevel::TRACE, fmt, std::forward<Args>(args)...);
     }
 
     /// @brief Log a message at the VERBOSE level.
+    /// @param message The message to log
+    void verbose(const std::string &message)
+    {
+        if (isEnabled(LogLevel::VERBOSE))
+            log(LogLevel::VERBOSE, message);
+    }
+
+    /// @brief Log a message at the VERBOSE level using a format string.
     /// @tparam ...Args The argument types for the format string
     /// @param fmt The format string
     /// @param ...args The arguments for the format string
-    template <typename... Args> void verbose(const std::string &fmt, Args &&...args)
+    template <typename... Args> void verbose(std::format_string<Args...> fmt, Args &&...args)
     {
         log(LogLevel::VERBOSE, fmt, std::forward<Args>(args)...);
     }
 
     /// @brief Log a message at the DEBUG level.
+    /// @param message The message to log
+    void debug(const std::string &message)
+    {
+        if (isEnabled(LogLevel::DEBUG))
+            log(LogLevel::DEBUG, message);
+    }
+
+    /// @brief Log a message at the DEBUG level using a format string.
     /// @tparam ...Args The argument types for the format string
     /// @param fmt The format string
     /// @param ...args The arguments for the format string
-    template <typename... Args> void debug(const std::string &fmt, Args &&...args)
+    template <typename... Args> void debug(std::format_string<Args...> fmt, Args &&...args)
     {
         log(LogLevel::DEBUG, fmt, std::forward<Args>(args)...);
     }
 
     /// @brief Log a message at the SUCCESS level.
+    /// @param message The message to log
+    void success(const std::string &message)
+    {
+        if (isEnabled(LogLevel::SUCCESS))
+            log(LogLevel::SUCCESS, message);
+    }
+
+    /// @brief Log a message at the SUCCESS level using a format string.
     /// @tparam ...Args The argument types for the format string
     /// @param fmt The format string
     /// @param ...args The arguments for the format string
-    template <typename... Args> void success(const std::string &fmt, Args &&...args)
+    template <typename... Args> void success(std::format_string<Args...> fmt, Args &&...args)
     {
         log(LogLevel::SUCCESS, fmt, std::forward<Args>(args)...);
     }
 
     /// @brief Log a message at the INFO level.
+    /// @param message The message to log
+    void info(const std::string &message)
+    {
+        if (isEnabled(LogLevel::INFO))
+            log(LogLevel::INFO, message);
+    }
+
+    /// @brief Log a message at the INFO level using a format string.
     /// @tparam ...Args The argument types for the format string
     /// @param fmt The format string
     /// @param ...args The arguments for the format string
-    template <typename... Args> void info(const std::string &fmt, Args &&...args)
+    template <typename... Args> void info(std::format_string<Args...> fmt, Args &&...args)
     {
         log(LogLevel::INFO, fmt, std::forward<Args>(args)...);
     }
 
     /// @brief Log a message at the WARNING level.
+    /// @param message The message to log
+    void warning(const std::string &message)
+    {
+        if (isEnabled(LogLevel::WARNING))
+            log(LogLevel::WARNING, message);
+    }
+
+    /// @brief Log a message at the WARNING level using a format string.
     /// @tparam ...Args The argument types for the format string
     /// @param fmt The format string
     /// @param ...args The arguments for the format string
-    template <typename... Args> void warning(const std::string &fmt, Args &&...args)
+    template <typename... Args> void warning(std::format_string<Args...> fmt, Args &&...args)
     {
         log(LogLevel::WARNING, fmt, std::forward<Args>(args)...);
     }
 
     /// @brief Log a message at the ERROR level.
+    /// @param message The message to log
+    void error(const std::string &message)
+    {
+        if (isEnabled(LogLevel::ERROR))
+            log(LogLevel::ERROR, message);
+    }
+
+    /// @brief Log a message at the ERROR level using a format string.
     /// @tparam ...Args The argument types for the format string
     /// @param fmt The format string
     /// @param ...args The arguments for the format string
-    template <typename... Args> void error(const std::string &fmt, Args &&...args)
+    template <typename... Args> void error(std::format_string<Args...> fmt, Args &&...args)
     {
         log(LogLevel::ERROR, fmt, std::forward<Args>(args)...);
     }
@@ -135,34 +274,58 @@ public:
 #pragma region LogStreamShortcuts
 
     /// @brief Get the stream for the TRACE log level.
-    /// @return The output stream for the TRACE log level
-    std::ostream &trace() { return getStream(LogLevel::TRACE); }
+    /// @return The output stream for the TRACE log level (a DisabledStream if compiled out)
+    LevelStream<LogLevel::TRACE> trace() { return levelStream<LogLevel::TRACE>(); }
 
     /// @brief Get the stream for the VERBOSE log level.
-    /// @return The output stream for the VERBOSE log level
-    std::ostream &verbose() { return getStream(LogLevel::VERBOSE); }
+    /// @return The output stream for the VERBOSE log level (a DisabledStream if compiled out)
+    LevelStream<LogLevel::VERBOSE> verbose() { return levelStream<LogLevel::VERBOSE>(); }
 
     /// @brief Get the stream for the DEBUG log level.
-    /// @return The output stream for the DEBUG log level
-    std::ostream &debug() { return getStream(LogLevel::DEBUG); }
+    /// @return The output stream for the DEBUG log level (a DisabledStream if compiled out)
+    LevelStream<LogLevel::DEBUG> debug() { return levelStream<LogLevel::DEBUG>(); }
 
     /// @brief Get the stream for the SUCCESS log level.
-    /// @return The output stream for the SUCCESS log level
-    std::ostream &success() { return getStream(LogLevel::SUCCESS); }
+    /// @return The output stream for the SUCCESS log level (a DisabledStream if compiled out)
+    LevelStream<LogLevel::SUCCESS> success() { return levelStream<LogLevel::SUCCESS>(); }
 
     /// @brief Get the stream for the INFO log level.
-    /// @return The output stream for the INFO log level
-    std::ostream &info() { return getStream(LogLevel::INFO); }
+    /// @return The output stream for the INFO log level (a DisabledStream if compiled out)
+    LevelStream<LogLevel::INFO> info() { return levelStream<LogLevel::INFO>(); }
 
     /// @brief Get the stream for the WARNING log level.
-    /// @return The output stream for the WARNING log level
-    std::ostream &warning() { return getStream(LogLevel::WARNING); }
+    /// @return The output stream for the WARNING log level (a DisabledStream if compiled out)
+    LevelStream<LogLevel::WARNING> warning() { return levelStream<LogLevel::WARNING>(); }
 
     /// @brief Get the stream for the ERROR log level.
-    /// @return The output stream for the ERROR log level
-    std::ostream &error() { return getStream(LogLevel::ERROR); }
+    /// @return The output stream for the ERROR log level (a DisabledStream if compiled out)
+    LevelStream<LogLevel::ERROR> error() { return levelStream<LogLevel::ERROR>(); }
 
 #pragma endregion LogStreamShortcuts
+
+protected:
+    /// @brief Get the stream of a level, or a DisabledStream if the level is removed at compile
+    /// time, so the streamed values are not even formatted.
+    /// @tparam Level The log level
+    /// @return The output stream for the log level
+    template <LogLevel Level> LevelStream<Level> levelStream()
+    {
+        if constexpr (isCompiledIn(Level))
+            return getStream(Level);
+        else
+            return DisabledStream{};
+    }
+
+    /// @brief Set the level isEnabled() compares against, implementations call this when their
+    /// minimum level changes. All levels are enabled by default.
+    /// @param lvl The new minimum log level
+    void setEnabledLevel(LogLevel lvl) noexcept
+    {
+        enabledLevel.store(lvl, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<LogLevel> enabledLevel{LogLevel::TRACE};
 };
 
 /// @brief Logger class for handling log messages.
@@ -192,16 +355,15 @@ public:
     /// @brief Remove all log handlers.
     void removeAllHandlers() override { handlers.clear(); }
 
+    using AbstractLogger::log;
     void log(LogLevel lvl, const std::string& msg) const override;
 
     std::ostream& getStream(LogLevel lvl) override;
 
 private:
-    LogLevel minLevel;
     std::vector<std::unique_ptr<AbstractHandler>> handlers;
 
-    // Per-level stream buffers & streams
-    std::unordered_map<LogLevel, std::unique_ptr<LogStreamBuf>> buffers;
-    std::unordered_map<LogLevel, std::unique_ptr<std::ostream>> streams;
+    // Per-level streams, separate for every thread
+    LogStreams streams;
 };
 } // namespace cli::logging
\ No newline at end of file
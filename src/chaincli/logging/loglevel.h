@@ -17,6 +17,13 @@
 #pragma once
 #include <string_view>
 
+/// @brief Compile-time minimum log level, as the number of a LogLevel (0 = TRACE ... 6 = ERROR).
+/// Logging calls below it are removed from the build, define it e.g. as 3 to only keep INFO and
+/// above in release builds.
+#ifndef CHAIN_CLI_MIN_LOG_LEVEL
+#define CHAIN_CLI_MIN_LOG_LEVEL 0
+#endif
+
 namespace cli::logging
 {
 
@@ -32,6 +39,17 @@ enum class LogLevel
     ERROR,     // a serious error occurred/ something failed
 };
 
+/// @brief The minimum log level compiled into the build, see CHAIN_CLI_MIN_LOG_LEVEL.
+inline constexpr auto compiledMinLevel = static_cast<LogLevel>(CHAIN_CLI_MIN_LOG_LEVEL);
+
+/// @brief Check if logging calls of a level are compiled into the build.
+/// @param level The log level
+/// @return False if calls of the level are removed at compile time.
+constexpr bool isCompiledIn(LogLevel level) noexcept
+{
+    return level >= compiledMinLevel;
+}
+
 inline std::string_view toString(LogLevel level)
 {
     switch (level)
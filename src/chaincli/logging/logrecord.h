@@ -37,6 +37,15 @@ struct LogRecord
     /// @param lvl The log level of the record.
     /// @param msg The log message.
     LogRecord(LogLevel lvl, std::string msg) : level(lvl), message(std::move(msg)) {}
+
+    /// @brief Construct a new LogRecord for a message logged at an earlier time.
+    /// @param lvl The log level of the record.
+    /// @param msg The log message.
+    /// @param time The time the message was logged.
+    LogRecord(LogLevel lvl, std::string msg, std::chrono::system_clock::time_point time)
+        : level(lvl), message(std::move(msg)), timestamp(time)
+    {
+    }
 };
 
 } // namespace cli::logging
\ No newline at end of file
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace cli::logging
+{
+
+/// @brief Bounded lock-free queue with a fixed number of slots.
+/// @details Every slot carries a sequence number that tells producers and consumers whose turn it
+/// is, so pushing or consuming an element only takes one compare-and-swap on the shared position
+/// and never blocks. Any number of threads may push and consume concurrently, the AsyncLogger
+/// uses a single consumer and lets producers consume as well to evict the oldest element.
+/// @tparam T The element type, elements are constructed and consumed in place.
+template <typename T> class RingBuffer
+{
+public:
+    /// @brief Construct an empty ring buffer.
+    /// @param capacity The minimum number of elements, rounded up to a power of two (at least 2).
+    explicit RingBuffer(size_t capacity)
+        : slotCount(std::bit_ceil(capacity < 2 ? size_t{2} : capacity)), mask(slotCount - 1),
+          slots(std::make_unique<Slot[]>(slotCount))
+    {
+        for (size_t i = 0; i < slotCount; ++i)
+        {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+    /// @brief Construct an element at the end of the queue, unless the queue is full.
+    /// @tparam ...Args The constructor argument types of the element.
+    /// @param ...args The constructor arguments of the element.
+    /// @return True if the element was added, false if the queue is full.
+    template <typename... Args> bool tryPush(Args &&...args)
+    {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot &slot = slots[pos & mask];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0)
+            {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    slot.value.emplace(std::forward<Args>(args)...);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // the slot still holds an element from the previous round
+            }
+            else
+            {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// @brief Pass the element at the front of the queue to a function and remove it afterwards.
+    /// @tparam F The function type.
+    /// @param consumer Called with a reference to the element, the element is removed even if it
+    /// throws.
+    /// @return True if an element was consumed, false if the queue is empty.
+    template <typename F> bool tryConsume(F &&consumer)
+    {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot &slot = slots[pos & mask];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+            if (diff == 0)
+            {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    // hands the slot to the producers of the next round
+                    struct Release
+                    {
+                        Slot &slot;
+                        size_t next;
+                        ~Release()
+                        {
+                            slot.value.reset();
+                            slot.sequence.store(next, std::memory_order_release);
+                        }
+                    } release{slot, pos + slotCount};
+
+                    std::invoke(std::forward<F>(consumer), *slot.value);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // the slot has not been written in this round yet
+            }
+            else
+            {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// @brief Get the number of elements pushed since construction, including ones that are still
+    /// being constructed. Elements are consumed in the order of this count.
+    /// @return The number of pushed elements.
+    [[nodiscard]] size_t pushedCount() const noexcept
+    {
+        return enqueuePos.load(std::memory_order_acquire);
+    }
+
+    /// @brief Get the number of slots of the queue.
+    /// @return The capacity, a power of two.
+    [[nodiscard]] size_t capacity() const noexcept { return slotCount; }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence{0};
+        std::optional<T> value;
+    };
+
+    const size_t slotCount;
+    const size_t mask;
+    std::unique_ptr<Slot[]> slots;
+
+    // producers and consumers update their position on separate cache lines
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) std::atomic<size_t> dequeuePos{0};
+};
+
+} // namespace cli::logging
@@ -0,0 +1,88 @@
+// Copyright 2025 Dominik Czekai
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "command_line.h"
+
+#include <format>
+
+#include "list_splitter.h"
+#include "parse_exception.h"
+
+#define inline_t
+
+namespace cli::parsing
+{
+inline_t void splitCommandLine(std::string_view line, std::pmr::string &storage,
+                               std::pmr::vector<std::string_view> &arguments)
+{
+    storage.clear();
+    arguments.clear();
+    // unescaping never makes an argument longer, so the views stay valid while appending
+    storage.reserve(line.size());
+
+    size_t pos = 0;
+    while (pos < line.size())
+    {
+        if (detail::isListSpace(line[pos]))
+        {
+            ++pos;
+            continue;
+        }
+        if (line[pos] == '#')
+        {
+            break;
+        }
+
+        const size_t argumentStart = storage.size();
+        while (pos < line.size() && !detail::isListSpace(line[pos]))
+        {
+            const char ch = line[pos++];
+            if (ch == '\'' || ch == '"')
+            {
+                bool terminated = false;
+                while (pos < line.size())
+                {
+                    char quoted = line[pos++];
+                    if (quoted == ch)
+                    {
+                        terminated = true;
+                        break;
+                    }
+                    if (ch == '"' && quoted == '\\' && pos < line.size() &&
+                        (line[pos] == '"' || line[pos] == '\\'))
+                    {
+                        quoted = line[pos++];
+                    }
+                    storage.push_back(quoted);
+                }
+                if (!terminated)
+                {
+                    throw CommandLineSyntaxException(
+                        std::format("Unterminated {} quote in command line: {}", ch, line), line);
+                }
+            }
+            else if (ch == '\\' && pos < line.size())
+            {
+                storage.push_back(line[pos++]);
+            }
+            else
+            {
+                storage.push_back(ch);
+            }
+        }
+        arguments.emplace_back(storage.data() + argumentStart, storage.size() - argumentStart);
+    }
+}
+} // namespace cli::parsing
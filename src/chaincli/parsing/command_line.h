@@ -0,0 +1,39 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cli::parsing
+{
+/// @brief Split a command line into its arguments, similar to a POSIX shell.
+/// @details Arguments are separated by unquoted whitespace. Inside single quotes every character
+/// is taken literally, inside double quotes a backslash only escapes '"' and '\\', outside of
+/// quotes it escapes any character. Quoted and unquoted parts that are not separated by
+/// whitespace form a single argument, so "" is an empty argument. An unquoted '#' at the start of
+/// an argument comments out the rest of the line.
+/// @param line The command line to split.
+/// @param storage Receives the unescaped characters of all arguments, its previous content is
+/// replaced.
+/// @param arguments Receives views into storage, one per argument, its previous content is
+/// replaced.
+/// @throws CommandLineSyntaxException if a quote is not terminated.
+void splitCommandLine(std::string_view line, std::pmr::string &storage,
+                      std::pmr::vector<std::string_view> &arguments);
+} // namespace cli::parsing
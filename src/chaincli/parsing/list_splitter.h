@@ -0,0 +1,199 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if !defined(CHAIN_CLI_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <immintrin.h>
+#define CHAIN_CLI_SPLITTER_SSE2
+#endif
+
+namespace cli::parsing
+{
+namespace detail
+{
+/// @brief Classification of a block of up to 64 input characters, one bit per character.
+struct BlockMasks
+{
+    /// @brief Characters equal to the delimiter.
+    uint64_t delimiters;
+    /// @brief Characters that are neither the delimiter nor whitespace.
+    uint64_t content;
+};
+
+/// @brief Number of characters classified at once.
+inline constexpr size_t blockSize = 64;
+
+/// @brief Check if a character is whitespace as defined by std::isspace in the "C" locale.
+constexpr bool isListSpace(char ch) noexcept
+{
+    const auto uch = static_cast<unsigned char>(ch);
+    return uch == ' ' || (uch >= '\t' && uch <= '\r');
+}
+
+/// @brief Classify a block of characters one at a time.
+/// @param block Pointer to the characters.
+/// @param length The number of characters to classify, at most blockSize.
+/// @param delimiter The delimiter separating the values.
+/// @return The masks of the block, bits at and above length are zero.
+inline BlockMasks scalarBlockMasks(const char *block, size_t length, char delimiter) noexcept
+{
+    BlockMasks masks{0, 0};
+    for (size_t i = 0; i < length; ++i)
+    {
+        const uint64_t bit = uint64_t{1} << i;
+        if (block[i] == delimiter)
+        {
+            masks.delimiters |= bit;
+        }
+        else if (!isListSpace(block[i]))
+        {
+            masks.content |= bit;
+        }
+    }
+    return masks;
+}
+
+#ifdef CHAIN_CLI_SPLITTER_SSE2
+/// @brief Classify a full block of blockSize characters with SSE2 (or AVX2 if available).
+/// @param block Pointer to the characters, blockSize of them have to be readable.
+/// @param delimiter The delimiter separating the values.
+/// @return The masks of the block.
+inline BlockMasks simdBlockMasks(const char *block, char delimiter) noexcept
+{
+    uint64_t delimiters = 0;
+    uint64_t spaces = 0;
+#ifdef __AVX2__
+    const __m256i delim = _mm256_set1_epi8(delimiter);
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i controlRange = _mm256_set1_epi8('\r' - '\t');
+    for (size_t offset = 0; offset < blockSize; offset += 32)
+    {
+        const __m256i chars =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + offset));
+        // '\t' to '\r' is a contiguous range, checked with an unsigned (x - '\t') <= 4
+        const __m256i shifted = _mm256_sub_epi8(chars, tab);
+        const __m256i isControl =
+            _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, controlRange), shifted);
+        const __m256i isSpace = _mm256_or_si256(_mm256_cmpeq_epi8(chars, space), isControl);
+        delimiters |= static_cast<uint64_t>(static_cast<uint32_t>(
+                          _mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, delim))))
+                      << offset;
+        spaces |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(isSpace)))
+                  << offset;
+    }
+#else
+    const __m128i delim = _mm_set1_epi8(delimiter);
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i controlRange = _mm_set1_epi8('\r' - '\t');
+    for (size_t offset = 0; offset < blockSize; offset += 16)
+    {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + offset));
+        // '\t' to '\r' is a contiguous range, checked with an unsigned (x - '\t') <= 4
+        const __m128i shifted = _mm_sub_epi8(chars, tab);
+        const __m128i isControl = _mm_cmpeq_epi8(_mm_min_epu8(shifted, controlRange), shifted);
+        const __m128i isSpace = _mm_or_si128(_mm_cmpeq_epi8(chars, space), isControl);
+        delimiters |= static_cast<uint64_t>(static_cast<uint32_t>(
+                          _mm_movemask_epi8(_mm_cmpeq_epi8(chars, delim))))
+                      << offset;
+        spaces |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(isSpace)))
+                  << offset;
+    }
+#endif
+    return BlockMasks{delimiters, ~(delimiters | spaces)};
+}
+#endif
+
+/// @brief Classify a block of characters with the fastest available implementation.
+/// @param block Pointer to the characters.
+/// @param length The number of characters to classify, at most blockSize.
+/// @param delimiter The delimiter separating the values.
+/// @return The masks of the block, bits at and above length are zero.
+inline BlockMasks blockMasks(const char *block, size_t length, char delimiter) noexcept
+{
+#ifdef CHAIN_CLI_SPLITTER_SSE2
+    if (length == blockSize)
+    {
+        return simdBlockMasks(block, delimiter);
+    }
+#endif
+    return scalarBlockMasks(block, length, delimiter);
+}
+} // namespace detail
+
+/// @brief Split a delimiter separated list into its values.
+/// @details Every value is trimmed of leading and trailing whitespace (as classified by
+/// std::isspace in the "C" locale) and empty values are skipped. The input is classified in
+/// blocks of 64 characters with SIMD instructions where available (SSE2/AVX2, disabled by defining
+/// CHAIN_CLI_NO_SIMD), so the cost per character does not depend on the length of the values.
+/// @tparam Visitor Callable taking a std::string_view.
+/// @param input The list to split.
+/// @param delimiter The delimiter separating the values.
+/// @param visit Called for every value in order, the values are views into input.
+template <typename Visitor>
+void forEachListValue(std::string_view input, char delimiter, Visitor &&visit)
+{
+    constexpr size_t none = static_cast<size_t>(-1);
+    // absolute positions of the first and last content character of the current value
+    size_t first = none;
+    size_t last = 0;
+
+    for (size_t base = 0; base < input.size(); base += detail::blockSize)
+    {
+        const size_t length = std::min(detail::blockSize, input.size() - base);
+        auto [delimiters, content] = detail::blockMasks(input.data() + base, length, delimiter);
+
+        while (true)
+        {
+            const uint64_t nextDelimiter = delimiters & (~delimiters + 1);
+            // all characters before the next delimiter, or the rest of the block
+            const uint64_t segment = nextDelimiter ? nextDelimiter - 1 : ~uint64_t{0};
+            if (const uint64_t segmentContent = content & segment)
+            {
+                if (first == none)
+                {
+                    first = base + static_cast<size_t>(std::countr_zero(segmentContent));
+                }
+                last = base + 63 - static_cast<size_t>(std::countl_zero(segmentContent));
+            }
+            if (!nextDelimiter)
+            {
+                break;
+            }
+
+            if (first != none)
+            {
+                visit(input.substr(first, last - first + 1));
+                first = none;
+            }
+            content &= ~(segment | nextDelimiter);
+            delimiters &= delimiters - 1;
+        }
+    }
+
+    if (first != none)
+    {
+        visit(input.substr(first, last - first + 1));
+    }
+}
+} // namespace cli::parsing
@@ -15,9 +15,11 @@
  */
 
 #pragma once
+#include <format>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <typeinfo>
-#include <format>
 #include "commands/argument.h"
 #include "commands/argument_group.h"
 
@@ -31,7 +33,7 @@ public:
     /// @param message The error message
     /// @param input The input string that failed to parse
     /// @param argument The argument that failed to parse
-    ParseException(const std::string &message, const std::string &input, const cli::commands::ArgumentBase &argument)
+    ParseException(const std::string &message, std::string_view input, const cli::commands::ArgumentBase &argument)
         : std::runtime_error(message), input(input), argument(argument)
     {
     }
@@ -39,7 +41,7 @@ public:
     /// @brief Construct a ParseException with default message, input string, and argument
     /// @param input The input string that failed to parse
     /// @param argument The argument that failed to parse
-    ParseException(const std::string &input, const cli::commands::ArgumentBase &argument)
+    ParseException(std::string_view input, const cli::commands::ArgumentBase &argument)
         : ParseException(std::format("Failed to parse input '{}' for argument: {}", input, argument.getName()), input, argument)
     {
     }
@@ -57,6 +59,54 @@ private:
     const cli::commands::ArgumentBase &argument;
 };
 
+/// @brief Exception thrown when an input matches none of the arguments of a command.
+class UnknownInputException : public std::runtime_error
+{
+public:
+    /// @brief Construct an UnknownInputException with a message and the unmatched input
+    /// @param message The error message
+    /// @param input The input that matched no argument
+    UnknownInputException(const std::string &message, std::string_view input)
+        : std::runtime_error(message), input(input)
+    {
+    }
+
+    /// @brief Construct an UnknownInputException with default message and the unmatched input
+    /// @param input The input that matched no argument
+    explicit UnknownInputException(std::string_view input)
+        : UnknownInputException(std::format("Unknown argument: {}", input), input)
+    {
+    }
+
+    /// @brief Gets the input that matched no argument
+    /// @return the input string
+    const std::string &getInput() const noexcept { return input; }
+
+private:
+    std::string input;
+};
+
+/// @brief Exception thrown when a command line cannot be split into arguments, e.g. because of an
+/// unterminated quote.
+class CommandLineSyntaxException : public std::runtime_error
+{
+public:
+    /// @brief Construct a CommandLineSyntaxException with a message and the command line
+    /// @param message The error message
+    /// @param input The command line that could not be split
+    CommandLineSyntaxException(const std::string &message, std::string_view input)
+        : std::runtime_error(message), input(input)
+    {
+    }
+
+    /// @brief Gets the command line that could not be split
+    /// @return the command line
+    const std::string &getInput() const noexcept { return input; }
+
+private:
+    std::string input;
+};
+
 /// @brief Exception thrown when the input string cannot be parsed to the needed type for an argument.
 class TypeParseException : public std::runtime_error
 {
@@ -65,7 +115,7 @@ public:
     /// @param message The error message
     /// @param input The input string that couldn't be parsed
     /// @param targetType The type it couldn't be parsed to
-    TypeParseException(const std::string &message, const std::string &input, const std::type_info &targetType)
+    TypeParseException(const std::string &message, std::string_view input, const std::type_info &targetType)
         : std::runtime_error(message), input(input), targetType(targetType)
     {
     }
@@ -73,7 +123,7 @@ public:
     /// @brief Construct a TypeParseException with default message, input string, and target type
     /// @param input The input string that couldn't be parsed
     /// @param targetType The type it couldn't be parsed to
-    TypeParseException(const std::string &input, const std::type_info &targetType)
+    TypeParseException(std::string_view input, const std::type_info &targetType)
         : TypeParseException(std::format("Could not parse '{}' to type '{}'", input, targetType.name()), input, targetType)
     {
     }
@@ -17,9 +17,10 @@
 #include <algorithm>
 #include <any>
 #include <iostream>
-#include <ranges>
 
 #include "cli_app.h"
+#include "commands/suggestion_index.h"
+#include "list_splitter.h"
 #include "parser_utils.h"
 
 // used by heady
@@ -27,115 +28,99 @@
 
 namespace cli::parsing
 {
-inline_t std::vector<std::any> Parser::parseRepeatableList(const cli::commands::TypedArgumentBase &arg,
-                                                  const std::string &input) const
+inline_t std::any Parser::convert(const cli::commands::TypedArgumentBase &arg,
+                                  std::string_view input) const
+{
+    if (configuration.lazyConversion)
+    {
+        return LazyValue{input, &arg};
+    }
+    return arg.parseToValue(input);
+}
+
+inline_t std::pmr::vector<std::any> Parser::parseRepeatableList(
+    const cli::commands::TypedArgumentBase &arg, std::string_view input,
+    std::pmr::memory_resource *resource) const
 {
 #ifdef CHAIN_CLI_VERBOSE
     std::cout << "Parsing repeatable list for argument of type: " << arg.getType().name()
               << " with delimiter-separated input: " << input << "\n";
 #endif
-    std::stringstream ss(input);
-    std::string token;
-    std::vector<std::any> parsedValues;
-
-    while (std::getline(ss, token, configuration.repeatableDelimiter))
-    {
-        // Trim leading whitespace
-        token.erase(token.begin(), std::ranges::find_if(
-                                       token, [](unsigned char ch) { return !std::isspace(ch); }));
-
-        // Trim trailing whitespace
-        token.erase(std::ranges::find_if(token | std::views::reverse,
-                                         [](unsigned char ch) { return !std::isspace(ch); })
-                        .base(),
-                    token.end());
+    std::pmr::vector<std::any> parsedValues(resource);
 
-        if (!token.empty())
-        {
-            parsedValues.push_back(arg.parseToValue(token));
-        }
-    }
+    forEachListValue(input, configuration.repeatableDelimiter, [&](std::string_view token) {
+        parsedValues.push_back(convert(arg, token));
+    });
 
     return parsedValues;
 }
 
-inline_t void Parser::parseRepeatable(const cli::commands::OptionArgumentBase &arg, const std::string &input,
-                             ContextBuilder &contextBuilder) const
+inline_t void Parser::parseRepeatable(const cli::commands::TypedArgumentBase &arg, size_t slot,
+                                      std::string_view input,
+                                      ContextBuilder &contextBuilder) const
 {
-    auto values = parseRepeatableList(arg, input);
-    contextBuilder.addRepeatableOptionArgument(arg.getName(), values);
+    contextBuilder.appendValues(
+        slot, parseRepeatableList(arg, input, contextBuilder.getMemoryResource()));
 }
 
-inline_t void Parser::parseRepeatable(const cli::commands::PositionalArgumentBase &arg,
-                             const std::string &input, ContextBuilder &contextBuilder) const
+inline_t bool Parser::tryOptionArg(const cli::commands::ArgumentIndex::Entry *entry,
+                                   std::span<const std::string_view> inputs, size_t index,
+                                   ContextBuilder &contextBuilder) const
 {
-    auto values = parseRepeatableList(arg, input);
-    contextBuilder.addRepeatablePositionalArgument(arg.getName(), values);
-}
+    if (!entry || entry->kind != cli::commands::ArgumentKind::Option)
+    {
+        return false;
+    }
 
-inline_t bool Parser::tryOptionArg(
-    const std::vector<std::shared_ptr<cli::commands::OptionArgumentBase>> &optionArguments,
-    const std::vector<std::string> &inputs, const std::string &currentParsing, size_t index,
-    ContextBuilder &contextBuilder) const
-{
-    const cli::commands::OptionArgumentBase *matchedOpt = nullptr;
-    for (const auto &opt : optionArguments)
+    const auto *matchedOpt = static_cast<const cli::commands::OptionArgumentBase *>(entry->argument);
+    if (index + 1 >= inputs.size())
     {
-        if (currentParsing == opt->getShortName() || currentParsing == opt->getName())
-        {
-            matchedOpt = opt.get();
-            break;
-        }
+        throw ParseException(
+            std::format("Option {} requires a value but none was provided", inputs[index]), "",
+            *matchedOpt);
+    }
+    std::string_view value = inputs[index + 1];
+
+    if (matchedOpt->isRepeatable())
+    {
+        parseRepeatable(*matchedOpt, entry->slot, value, contextBuilder);
     }
-    if (matchedOpt)
+    else
     {
-        if (matchedOpt->isRepeatable())
+        if (contextBuilder.isSlotPresent(entry->slot))
         {
-            parseRepeatable(*matchedOpt, inputs[index + 1], contextBuilder);
+            throw ParseException(
+                std::format("Non Repeatable Argument {} was repeated", matchedOpt->getName()),
+                value, *matchedOpt);
         }
-        else
-        {
-            if (!matchedOpt->isRepeatable() &&
-                contextBuilder.isArgPresent(std::string(matchedOpt->getName())))
-            {
-                throw ParseException(
-                    std::format("Non Repeatable Argument {} was repeated", matchedOpt->getName()),
-                    inputs[index + 1], *matchedOpt);
-            }
 
-            auto val = matchedOpt->parseToValue(inputs[index + 1]);
-            contextBuilder.addOptionArgument(matchedOpt->getName(), val);
-        }
-        return true;
+        contextBuilder.setValue(entry->slot, convert(*matchedOpt, value));
     }
-    return false;
+    return true;
 }
 
-inline_t bool Parser::tryFlagArg(
-    const std::vector<std::shared_ptr<cli::commands::FlagArgument>> &flagArguments,
-    const std::string &currentParsing, ContextBuilder &contextBuilder) const
+inline_t bool Parser::tryFlagArg(const cli::commands::ArgumentIndex::Entry *entry,
+                                 ContextBuilder &contextBuilder) const
 {
-    const cli::commands::FlagArgument *matchedFlag = nullptr;
-    for (const auto &flag : flagArguments)
-    {
-        if (currentParsing == flag->getShortName() || currentParsing == flag->getName())
-        {
-            matchedFlag = flag.get();
-            break;
-        }
-    }
-    if (matchedFlag)
+    if (!entry || entry->kind != cli::commands::ArgumentKind::Flag)
     {
-        contextBuilder.addFlagArgument(matchedFlag->getShortName());
-        contextBuilder.addFlagArgument(matchedFlag->getName());
-        return true;
+        return false;
     }
-    return false;
+    contextBuilder.setFlag(entry->slot);
+    return true;
 }
 
 inline_t void cli::parsing::Parser::parseArguments(const cli::commands::Command &command,
                                           const std::vector<std::string> &inputs,
                                           ContextBuilder &contextBuilder) const
+{
+    std::vector<std::string_view> inputViews(inputs.begin(), inputs.end());
+    parseArguments(command, inputViews, contextBuilder);
+}
+
+inline_t void cli::parsing::Parser::parseArguments(const cli::commands::Command &command,
+                                          std::span<const std::string_view> inputs,
+                                          ContextBuilder &contextBuilder) const
 {
 #ifdef CHAIN_CLI_VERBOSE
     std::cout << "Parsing arguments for command: " << command.getIdentifier() << "\n";
@@ -148,14 +133,15 @@ inline_t void cli::parsing::Parser::parseArguments(const cli::commands::Command
 #endif
 
     const auto &posArguments = command.getPositionalArguments();
-    const auto &optArguments = command.getOptionArguments();
-    const auto &flagArguments = command.getFlagArguments();
+    const auto &argumentIndex = command.getArgumentIndex();
+    contextBuilder.bind(argumentIndex);
 
     size_t posArgsIndex = 0;
     for (size_t i = 0; i < inputs.size(); ++i)
     {
-        const auto &input = inputs[i];
-        if (tryOptionArg(optArguments, inputs, input, i, contextBuilder))
+        std::string_view input = inputs[i];
+        const auto *entry = argumentIndex.find(input);
+        if (tryOptionArg(entry, inputs, i, contextBuilder))
         {
 #ifdef CHAIN_CLI_VERBOSE
             std::cout << "Processed option argument: " << input << "\n";
@@ -164,7 +150,7 @@ inline_t void cli::parsing::Parser::parseArguments(const cli::commands::Command
             continue;
         }
 
-        if (tryFlagArg(flagArguments, input, contextBuilder))
+        if (tryFlagArg(entry, contextBuilder))
         {
 #ifdef CHAIN_CLI_VERBOSE
             std::cout << "Processed flag argument: " << input << "\n";
@@ -174,30 +160,44 @@ inline_t void cli::parsing::Parser::parseArguments(const cli::commands::Command
 
         if (posArgsIndex >= posArguments.size())
         {
+            // an input that looks like an option or that a command without positional arguments
+            // gets is most likely a mistyped option
+            if (posArguments.empty() || input.starts_with('-'))
+            {
+                std::string message = std::format("Unknown argument: {}", input);
+                if (const auto suggestions = cli::commands::formatSuggestions(
+                        argumentIndex.suggest(input, configuration.suggestionLimit));
+                    !suggestions.empty())
+                {
+                    message += ". " + suggestions;
+                }
+                throw UnknownInputException(message, input);
+            }
             throw ParseException(std::format("More positional arguments were provided than the "
                                              "command accepts with input: {}",
                                              input),
                                  input, *(posArguments.back()));
         }
 
-        if (const auto &posArg = *posArguments.at(posArgsIndex); posArg.isRepeatable())
+        const auto &posArg = *posArguments.at(posArgsIndex);
+        size_t posSlot = argumentIndex.positionalSlot(posArgsIndex);
+        if (posArg.isRepeatable())
         {
-            parseRepeatable(posArg, input, contextBuilder);
+            parseRepeatable(posArg, posSlot, input, contextBuilder);
         }
         else
         {
-            if (!posArg.isRepeatable() &&
-                contextBuilder.isArgPresent(std::string(posArg.getName())))
+            if (contextBuilder.isSlotPresent(posSlot))
             {
                 throw ParseException(
                     std::format("Non Repeatable Argument {} was repeated", posArg.getName()), input,
                     posArg);
             }
-            auto val = posArg.parseToValue(input);
+            auto val = convert(posArg, input);
 #ifdef CHAIN_CLI_VERBOSE
             std::cout << "Processed positional argument: " << input << "\n";
 #endif
-            contextBuilder.addPositionalArgument(posArg.getName(), val);
+            contextBuilder.setValue(posSlot, std::move(val));
         }
 
         ++posArgsIndex;
@@ -205,19 +205,26 @@ inline_t void cli::parsing::Parser::parseArguments(const cli::commands::Command
     checkGroupsAndRequired(command, contextBuilder);
 }
 
+inline_t bool isPresent(const cli::commands::ArgumentBase &arg,
+                        const commands::ArgumentIndex &argumentIndex,
+                        const ContextBuilder &contextBuilder)
+{
+    return contextBuilder.isSlotPresent(argumentIndex.findSlot(arg.getName()));
+}
+
 inline_t void exclusiveCheck(const commands::ArgumentGroup *argGroup,
+                             const commands::ArgumentIndex &argumentIndex,
                              const ContextBuilder &contextBuilder)
 {
     const cli::commands::ArgumentBase *firstProvided = nullptr;
 
     for (const auto &argPtr : argGroup->getArguments())
     {
-        if (!firstProvided && contextBuilder.isArgPresent(std::string(argPtr->getName())))
+        if (!firstProvided && isPresent(*argPtr, argumentIndex, contextBuilder))
         {
             firstProvided = argPtr.get();
         }
-        else if (contextBuilder.isArgPresent(std::string(argPtr->getName())) &&
-                 firstProvided != nullptr)
+        else if (isPresent(*argPtr, argumentIndex, contextBuilder) && firstProvided != nullptr)
         {
             throw GroupParseException(
                 std::format("Two arguments of mutually exclusive group were present: {} and {}",
@@ -228,17 +235,18 @@ inline_t void exclusiveCheck(const commands::ArgumentGroup *argGroup,
 }
 
 inline_t void inclusiveCheck(const commands::ArgumentGroup *argGroup,
+                             const commands::ArgumentIndex &argumentIndex,
                              const ContextBuilder &contextBuilder)
 {
     const cli::commands::ArgumentBase *firstProvided = nullptr;
 
     for (const auto &argPtr : argGroup->getArguments())
     {
-        if (!firstProvided && contextBuilder.isArgPresent(std::string(argPtr->getName())))
+        if (!firstProvided && isPresent(*argPtr, argumentIndex, contextBuilder))
         {
             firstProvided = argPtr.get();
         }
-        else if (!contextBuilder.isArgPresent(std::string(argPtr->getName())))
+        else if (!isPresent(*argPtr, argumentIndex, contextBuilder))
         {
             throw GroupParseException(
                 std::format("Missing argument in mutually exclusive group: {}", argPtr->getName()),
@@ -248,11 +256,12 @@ inline_t void inclusiveCheck(const commands::ArgumentGroup *argGroup,
 }
 
 inline_t void checkRequired(const commands::ArgumentGroup *argGroup,
+                            const commands::ArgumentIndex &argumentIndex,
                             const ContextBuilder &contextBuilder)
 {
     for (const auto &argPtr : argGroup->getArguments())
     {
-        if (argPtr->isRequired() && !contextBuilder.isArgPresent(std::string(argPtr->getName())))
+        if (argPtr->isRequired() && !isPresent(*argPtr, argumentIndex, contextBuilder))
         {
             throw ParseException(std::format("Required argument {} is missing", argPtr->getName()),
                                  "", *argPtr);
@@ -260,20 +269,41 @@ inline_t void checkRequired(const commands::ArgumentGroup *argGroup,
     }
 }
 
+inline_t bool satisfiesGroupsAndRequired(const commands::ArgumentIndex &argumentIndex,
+                                         const commands::SlotSet &present)
+{
+    for (const auto &mask : argumentIndex.getGroupMasks())
+    {
+        if (mask.group->isExclusive() && mask.members.countCommon(present) > 1)
+            return false;
+        if (mask.group->isInclusive() && !mask.members.isSubsetOf(present))
+            return false;
+    }
+    return argumentIndex.getRequiredSlots().isSubsetOf(present);
+}
+
 inline_t void Parser::checkGroupsAndRequired(const cli::commands::Command &command,
                                     const ContextBuilder &contextBuilder) const
 {
+    const auto &argumentIndex = command.getArgumentIndex();
+    // the masks are precomputed with the index, so valid inputs only cost a few word operations;
+    // the group by group checks below are only run to report the first violation
+    if (satisfiesGroupsAndRequired(argumentIndex, contextBuilder.getPresentSlots()))
+    {
+        return;
+    }
+
     for (const auto &argGroup : command.getArgumentGroups())
     {
         if (argGroup->isExclusive())
         {
-            exclusiveCheck(argGroup.get(), contextBuilder);
+            exclusiveCheck(argGroup.get(), argumentIndex, contextBuilder);
         }
         else if (argGroup->isInclusive())
         {
-            inclusiveCheck(argGroup.get(), contextBuilder);
+            inclusiveCheck(argGroup.get(), argumentIndex, contextBuilder);
         }
-        checkRequired(argGroup.get(), contextBuilder);
+        checkRequired(argGroup.get(), argumentIndex, contextBuilder);
     }
 }
 
@@ -16,7 +16,10 @@
 
 #pragma once
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "cli_config.h"
@@ -35,6 +38,17 @@ public:
     /// @param config The configuration to use for the parser.
     explicit Parser(const CliConfig &config) : configuration(config) {}
 
+    /// @brief Parse the given inputs according to the specified command and populate the context
+    /// builder with the parsed values.
+    /// @note The inputs are only viewed, strings are only allocated for values that need to own
+    /// them (e.g. arguments of type std::string).
+    /// @param command The command to parse the inputs for.
+    /// @param inputs The inputs to parse.
+    /// @param contextBuilder The context builder to populate with the parsed values.
+    void parseArguments(const cli::commands::Command &command,
+                        std::span<const std::string_view> inputs,
+                        ContextBuilder &contextBuilder) const;
+
     /// @brief Parse the given inputs according to the specified command and populate the context
     /// builder with the parsed values.
     /// @param command The command to parse the inputs for.
@@ -45,25 +59,25 @@ public:
                         ContextBuilder &contextBuilder) const;
 
 private:
-    std::vector<std::any> parseRepeatableList(const cli::commands::TypedArgumentBase &arg,
-                                 const std::string &input) const;
+    // converts the input or defers the conversion, depending on the configuration
+    std::any convert(const cli::commands::TypedArgumentBase &arg, std::string_view input) const;
 
-    void parseRepeatable(const cli::commands::OptionArgumentBase &arg, const std::string &input,
-                         ContextBuilder &ContextBuilder) const;
+    std::pmr::vector<std::any> parseRepeatableList(const cli::commands::TypedArgumentBase &arg,
+                                                   std::string_view input,
+                                                   std::pmr::memory_resource *resource) const;
 
-    void parseRepeatable(const cli::commands::PositionalArgumentBase &arg, const std::string &input,
-                         ContextBuilder &ContextBuilder) const;
+    void parseRepeatable(const cli::commands::TypedArgumentBase &arg, size_t slot,
+                         std::string_view input, ContextBuilder &contextBuilder) const;
 
     void checkGroupsAndRequired(const cli::commands::Command &command,
                      const ContextBuilder &contextBuilder) const;
 
-    bool tryOptionArg(
-        const std::vector<std::shared_ptr<cli::commands::OptionArgumentBase>> &optionArguments,
-        const std::vector<std::string> &inputs, const std::string &currentParsing, size_t index,
-        ContextBuilder &contextBuilder) const;
+    bool tryOptionArg(const cli::commands::ArgumentIndex::Entry *entry,
+                      std::span<const std::string_view> inputs, size_t index,
+                      ContextBuilder &contextBuilder) const;
 
-    bool tryFlagArg(const std::vector<std::shared_ptr<cli::commands::FlagArgument>> &flagArguments,
-                    const std::string &currentParsing, ContextBuilder &contextBuilder) const;
+    bool tryFlagArg(const cli::commands::ArgumentIndex::Entry *entry,
+                    ContextBuilder &contextBuilder) const;
 
     const CliConfig &configuration;
 };
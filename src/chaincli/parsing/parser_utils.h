@@ -15,52 +15,130 @@
  */
 
 #pragma once
+#include <cctype>
+#include <charconv>
+#include <format>
 #include <iostream>
 #include <sstream>
 #include <string>
-#include <format>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 
 #include "parse_exception.h"
 
 namespace cli::parsing
 {
 /// @brief Helper struct providing static methods for parsing strings into various types.
+/// @details The conversion is selected at compile time: strings are copied (string_views just view
+/// the input), characters have to be a single character, integral and floating point types are
+/// converted with std::from_chars, bool with a dedicated parser and only all other (user defined)
+/// types fall back to operator>> on a std::istringstream.
 struct ParseHelper
 {
     /// @brief Parses a string input into a value of type T.
     /// @tparam T The type to parse the input into.
     /// @param input The input string to parse.
     /// @return The parsed value of type T.
-    template <typename T> static T parse(const std::string &input)
+    /// @throws TypeParseException if the input is not a valid value of type T.
+    template <typename T> static T parse(std::string_view input)
     {
-        std::istringstream iss(input);
-        T value;
-
         if constexpr (std::is_same_v<T, std::string>)
         {
-            return input; // For strings, just return
+            return std::string(input); // For strings, just return
+        }
+        else if constexpr (std::is_same_v<T, std::string_view>)
+        {
+            return input; // views into the inputs, which have to outlive the value
+        }
+        else if constexpr (std::is_same_v<T, bool>)
+        {
+            return parseBool(input);
+        }
+        else if constexpr (isCharType<T>)
+        {
+            if (input.size() != 1)
+            {
+                throwParseError<T>(input);
+            }
+            return static_cast<T>(input.front());
+        }
+        else if constexpr (isFromCharsType<T>)
+        {
+            return parseNumber<T>(input);
         }
         else
         {
             // Use operator>> for all other types
+            std::istringstream iss{std::string(input)};
+            T value;
             iss >> value;
             if (iss.fail() || !iss.eof())
             {
-                throw TypeParseException(std::format("Failed to parse value of type {} from input: {}", typeid(T).name(), input), input, typeid(T));
+                throwParseError<T>(input);
             }
+            return value;
         }
-
-        return value;
     }
 
     /// @brief Parses a string input into a value of type T.
     /// @tparam T The type to parse the input into.
     /// @param input The input string to parse.
     /// @param value The variable to store the parsed value.
-    template <typename T> static void parse(const std::string &input, T &value)
+    template <typename T> static void parse(std::string_view input, T &value)
     {
         // Call the return-by-value version and assign
         value = parse<T>(input);
     }
+
+private:
+    template <typename T>
+    static constexpr bool isCharType = std::is_same_v<T, char> ||
+                                       std::is_same_v<T, signed char> ||
+                                       std::is_same_v<T, unsigned char>;
+
+    // wide character types have no meaningful from_chars conversion, they keep using operator>>
+    template <typename T>
+    static constexpr bool isFromCharsType =
+        (std::is_integral_v<T> || std::is_floating_point_v<T>) && !std::is_same_v<T, bool> &&
+        !isCharType<T> && !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char8_t> &&
+        !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+
+    template <typename T> [[noreturn]] static void throwParseError(std::string_view input)
+    {
+        throw TypeParseException(std::format("Failed to parse value of type {} from input: {}", typeid(T).name(), input), input, typeid(T));
+    }
+
+    template <typename T> static T parseNumber(std::string_view input)
+    {
+        // operator>> skipped leading whitespace and accepted a leading '+', keep doing so
+        std::string_view digits = input;
+        while (!digits.empty() && std::isspace(static_cast<unsigned char>(digits.front())))
+        {
+            digits.remove_prefix(1);
+        }
+        if (digits.size() > 1 && digits.front() == '+' && digits[1] != '-')
+        {
+            digits.remove_prefix(1);
+        }
+
+        T value{};
+        const char *last = digits.data() + digits.size();
+        auto [ptr, ec] = std::from_chars(digits.data(), last, value);
+        if (ec != std::errc() || ptr != last)
+        {
+            throwParseError<T>(input);
+        }
+        return value;
+    }
+
+    static bool parseBool(std::string_view input)
+    {
+        if (input == "1" || input == "true")
+            return true;
+        if (input == "0" || input == "false")
+            return false;
+        throwParseError<bool>(input);
+    }
 };
 } // namespace cli::parsing
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "cli_app.h"
+#include "cli_config.h"
+#include "commands/command.h"
+#include "context_builder.h"
+#include "logging/formatter.h"
+#include "logging/handler.h"
+#include "logging/logger.h"
+#include "parsing/parser.h"
+
+using namespace cli;
+using namespace cli::commands;
+using cli::allocations::AllocationCounter;
+using cli::allocations::countAllocations;
+
+// The budgets are the allocation counts of the current implementation. If a change needs more,
+// it has to raise the budget explicitly, if it needs less, the budget should be lowered.
+
+namespace
+{
+// discards everything written to it without allocating
+class NullBuffer : public std::streambuf
+{
+protected:
+    int overflow(int ch) override { return ch; }
+    std::streamsize xsputn(const char *, std::streamsize count) override { return count; }
+};
+} // namespace
+
+TEST(AllocationCounterTest, CountsAllocationsOfTheBlockOnly)
+{
+    auto before = std::make_unique<int>(1);
+
+    const size_t allocations = countAllocations([] {
+        auto first = std::make_unique<int>(2);
+        auto second = std::make_unique<std::string>(100, 'x');
+    });
+
+    EXPECT_EQ(allocations, 3);
+}
+
+TEST(AllocationCounterTest, NestedCountersSeeInnerAllocations)
+{
+    AllocationCounter outer;
+    auto first = std::make_unique<int>(1);
+    {
+        AllocationCounter inner;
+        auto second = std::make_unique<int>(2);
+        EXPECT_EQ(inner.allocations(), 1);
+        EXPECT_EQ(inner.bytes(), sizeof(int));
+    }
+    EXPECT_EQ(outer.allocations(), 2);
+}
+
+class ParseAllocationBudgetTest : public ::testing::Test
+{
+public:
+    CliConfig config;
+    parsing::Parser parser{config};
+    logging::Logger logger{logging::LogLevel::ERROR};
+    Command command{"cmd"};
+    std::vector<std::string_view> inputs{"file.txt", "--a", "1", "--b",       "2", "--c",
+                                         "3",        "--d", "4", "--e",       "5", "--verbose"};
+
+    void SetUp() override
+    {
+        command.withPositionalArgument(PositionalArgument<std::string>("file"))
+            .withOptionArgument(OptionArgument<int>("--a", "n"))
+            .withOptionArgument(OptionArgument<int>("--b", "n"))
+            .withOptionArgument(OptionArgument<int>("--c", "n"))
+            .withOptionArgument(OptionArgument<int>("--d", "n"))
+            .withOptionArgument(OptionArgument<int>("--e", "n"))
+            .withFlagArgument(FlagArgument("--verbose", "-v"));
+        command.buildArgumentIndex();
+
+        // warm up, so lazily built state is not counted
+        ContextBuilder builder(command.getArgumentIndex());
+        parser.parseArguments(command, inputs, builder);
+        builder.build(logger);
+    }
+};
+
+TEST_F(ParseAllocationBudgetTest, ParseOfFiveOptions)
+{
+    ContextBuilder builder(command.getArgumentIndex());
+
+    const size_t allocations =
+        countAllocations([&] { parser.parseArguments(command, inputs, builder); });
+
+    EXPECT_LE(allocations, 1);
+}
+
+TEST_F(ParseAllocationBudgetTest, BuildOfFiveOptions)
+{
+    ContextBuilder builder(command.getArgumentIndex());
+    parser.parseArguments(command, inputs, builder);
+    std::unique_ptr<CliContext> context;
+
+    const size_t allocations = countAllocations([&] { context = builder.build(logger); });
+
+    EXPECT_LE(allocations, 1);
+}
+
+TEST(RunAllocationBudgetTest, RunOfFiveOptionsOnWarmedApp)
+{
+    CliApp app(CliConfig{}, std::make_unique<logging::Logger>(logging::LogLevel::ERROR));
+    app.withCommand(std::move(Command("cmd")
+                                  .withPositionalArgument(PositionalArgument<std::string>("file"))
+                                  .withOptionArgument(OptionArgument<int>("--a", "n"))
+                                  .withOptionArgument(OptionArgument<int>("--b", "n"))
+                                  .withOptionArgument(OptionArgument<int>("--c", "n"))
+                                  .withOptionArgument(OptionArgument<int>("--d", "n"))
+                                  .withOptionArgument(OptionArgument<int>("--e", "n"))
+                                  .withFlagArgument(FlagArgument("--verbose", "-v"))
+                                  .withExecutionFunc([](const CliContext &) {})));
+    const std::vector<std::string_view> args{"cmd", "file.txt", "--a", "1", "--b", "2", "--c",
+                                             "3",   "--d",      "4",   "--e", "5", "--verbose"};
+    app.init();
+    app.run(args);
+
+    const size_t allocations = countAllocations([&] { app.run(args); });
+
+    EXPECT_LE(allocations, 3);
+}
+
+class LogAllocationBudgetTest : public ::testing::Test
+{
+public:
+    NullBuffer buffer;
+    std::ostream out{&buffer};
+    std::string message = "a message that is too long for the small string optimization";
+};
+
+TEST_F(LogAllocationBudgetTest, LoggerLogWithOneHandler)
+{
+    logging::Logger logger(logging::LogLevel::TRACE);
+    logger.addHandler(std::make_unique<logging::BaseHandler>(
+        out, out, std::make_shared<logging::MessageOnlyFormatter>(), logging::LogLevel::TRACE));
+    logger.log(logging::LogLevel::INFO, message);
+
+    const size_t allocations =
+        countAllocations([&] { logger.log(logging::LogLevel::INFO, message); });
+
+    EXPECT_LE(allocations, 5);
+}
+
+TEST_F(LogAllocationBudgetTest, LoggerLogBelowMinimumLevel)
+{
+    logging::Logger logger(logging::LogLevel::ERROR);
+    logger.addHandler(std::make_unique<logging::BaseHandler>(
+        out, out, std::make_shared<logging::MessageOnlyFormatter>(), logging::LogLevel::TRACE));
+
+    const size_t allocations =
+        countAllocations([&] { logger.log(logging::LogLevel::INFO, message); });
+
+    EXPECT_EQ(allocations, 0);
+}
+
+TEST_F(LogAllocationBudgetTest, BaseHandlerEmitWithMessageOnlyFormatter)
+{
+    logging::BaseHandler handler(out, out, std::make_shared<logging::MessageOnlyFormatter>(),
+                                 logging::LogLevel::TRACE);
+    const logging::LogRecord record(logging::LogLevel::INFO, message);
+
+    const size_t allocations = countAllocations([&] { handler.emit(record); });
+
+    EXPECT_LE(allocations, 2);
+}
+
+TEST_F(LogAllocationBudgetTest, BaseHandlerEmitWithBasicFormatterAndStyles)
+{
+    logging::BaseHandler handler(out, out, std::make_shared<logging::BasicFormatter>(),
+                                 logging::LogLevel::TRACE,
+                                 std::make_shared<logging::LogStyleMap>(logging::defaultStyles()));
+    const logging::LogRecord record(logging::LogLevel::INFO, message);
+    handler.emit(record);
+
+    const size_t allocations = countAllocations([&] { handler.emit(record); });
+
+    EXPECT_LE(allocations, 3);
+}
@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cli_app.h"
+#include "commands/command.h"
+#include "logging/formatter.h"
+#include "logging/handler.h"
+#include "logging/logger.h"
+
+using namespace cli;
+using namespace cli::commands;
+
+namespace
+{
+// forwards to the default resource and counts what is still allocated
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    size_t allocations{0};
+    size_t bytesInUse{0};
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        bytesInUse += bytes;
+        return std::pmr::get_default_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+        bytesInUse -= bytes;
+        std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+} // namespace
+
+class CliAppTestSociable : public ::testing::Test
+{
+public:
+    CliApp app{CliConfig{}, std::make_unique<logging::Logger>(logging::LogLevel::ERROR)};
+    std::vector<int> receivedIds;
+    std::string receivedName;
+    std::vector<std::string> allReceivedNames;
+
+    void SetUp() override
+    {
+        app.withCommand(std::move(
+            Command("cmd")
+                .withPositionalArgument(PositionalArgument<std::string>("name"))
+                .withOptionArgument(OptionArgument<int>("--ids", "id").withRepeatable(true))
+                .withExecutionFunc([this](const CliContext &ctx) {
+                    receivedName = ctx.getPositionalArg<std::string>("name");
+                    allReceivedNames.push_back(receivedName);
+                    receivedIds = ctx.getRepeatableOptionArg<int>("--ids");
+                })));
+    }
+};
+
+TEST_F(CliAppTestSociable, InvocationStateIsAllocatedFromArenaAndReleased)
+{
+    CountingResource upstream;
+    app.setMemoryResource(&upstream);
+
+    std::vector<std::string_view> args{"cmd", "a-name-that-does-not-fit-into-sso", "--ids",
+                                       "1,2,3"};
+    app.run(args);
+
+    EXPECT_EQ(receivedName, "a-name-that-does-not-fit-into-sso");
+    EXPECT_EQ(receivedIds, (std::vector<int>{1, 2, 3}));
+    EXPECT_GT(upstream.allocations, 0);
+    EXPECT_EQ(upstream.bytesInUse, 0);
+}
+
+TEST_F(CliAppTestSociable, RunsWithoutMemoryResource)
+{
+    std::vector<std::string_view> args{"cmd", "name", "--ids", "4"};
+    app.run(args);
+
+    EXPECT_EQ(receivedName, "name");
+    EXPECT_EQ(receivedIds, (std::vector<int>{4}));
+}
+
+TEST_F(CliAppTestSociable, BatchRunsEveryLine)
+{
+    std::istringstream input("cmd first --ids 1\n"
+                             "\n"
+                             "# a comment\n"
+                             "cmd 'second name' --ids \"2, 3\"\n");
+
+    EXPECT_EQ(app.runBatch(input), 0);
+
+    EXPECT_EQ(allReceivedNames, (std::vector<std::string>{"first", "second name"}));
+    EXPECT_EQ(receivedIds, (std::vector<int>{2, 3}));
+}
+
+TEST_F(CliAppTestSociable, BatchContinuesAfterFailingLine)
+{
+    std::istringstream input("cmd first --ids x\n"
+                             "cmd \"unterminated\n"
+                             "cmd third\n");
+
+    EXPECT_EQ(app.runBatch(input), 1);
+
+    EXPECT_EQ(allReceivedNames, (std::vector<std::string>{"third"}));
+}
+
+TEST_F(CliAppTestSociable, BatchReportsUnknownCommandLine)
+{
+    std::istringstream input("cmd first\n"
+                             "unknown-command\n"
+                             "cmd third\n");
+
+    EXPECT_EQ(app.runBatch(input), 1);
+
+    EXPECT_EQ(allReceivedNames, (std::vector<std::string>{"first", "third"}));
+}
+
+TEST_F(CliAppTestSociable, BatchReleasesLineStateBetweenLines)
+{
+    CountingResource upstream;
+    app.setMemoryResource(&upstream);
+    std::string lines;
+    for (int i = 0; i < 100; ++i)
+    {
+        lines += "cmd a-name-that-does-not-fit-into-sso --ids 1,2,3\n";
+    }
+    std::istringstream input(lines);
+
+    EXPECT_EQ(app.runBatch(input), 0);
+
+    EXPECT_EQ(allReceivedNames.size(), 100u);
+    EXPECT_EQ(upstream.bytesInUse, 0);
+}
+
+TEST_F(CliAppTestSociable, CompleteEntryPointPrintsCandidates)
+{
+    const std::vector<std::string_view> args{"__complete", "--", "cmd", "--i"};
+
+    ::testing::internal::CaptureStdout();
+    EXPECT_EQ(app.run(args), 0);
+    const std::string output = ::testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(output, "--ids\t<id>\n");
+    EXPECT_TRUE(allReceivedNames.empty());
+    EXPECT_FALSE(app.getCommandTree().isFrozen());
+}
+
+TEST_F(CliAppTestSociable, CompleteEntryPointPrintsScript)
+{
+    app.getConfig().executableName = "tool";
+    const std::vector<std::string_view> args{"__complete", "--script", "bash"};
+
+    ::testing::internal::CaptureStdout();
+    EXPECT_EQ(app.run(args), 0);
+    const std::string output = ::testing::internal::GetCapturedStdout();
+
+    EXPECT_NE(output.find("complete -o default -F _tool_complete tool"), std::string::npos);
+}
+
+class CliAppUnknownCommandTestSociable : public ::testing::Test
+{
+public:
+    std::ostringstream out;
+    std::ostringstream err;
+    std::unique_ptr<CliApp> app;
+
+    void SetUp() override
+    {
+        auto logger = std::make_unique<logging::Logger>(logging::LogLevel::TRACE);
+        logger->addHandler(std::make_unique<logging::BaseHandler>(
+            out, err, std::make_shared<logging::MessageOnlyFormatter>(), logging::LogLevel::TRACE));
+        app = std::make_unique<CliApp>(CliConfig{}, std::move(logger));
+
+        Command remote("remote");
+        remote.withSubCommand(std::move(
+            Command("add").withShortDescription("add a remote").withExecutionFunc(
+                [](const CliContext &) {})));
+        app->withCommand(std::move(remote));
+        app->withCommand(std::move(Command("status")
+                                       .withShortDescription("show the status")
+                                       .withExecutionFunc([](const CliContext &) {})));
+    }
+};
+
+TEST_F(CliAppUnknownCommandTestSociable, SuggestsClosestCommandInsteadOfPrintingHelp)
+{
+    const std::vector<std::string_view> args{"statsu"};
+
+    EXPECT_EQ(app->run(args), 1);
+
+    EXPECT_NE(err.str().find("Unknown command: statsu\nDid you mean 'status'?"),
+              std::string::npos);
+    EXPECT_EQ(out.str().find("show the status"), std::string::npos);
+}
+
+TEST_F(CliAppUnknownCommandTestSociable, SuggestsAmongSubCommandsOfLocatedCommand)
+{
+    const std::vector<std::string_view> args{"remote", "ad"};
+
+    app->run(args);
+
+    EXPECT_NE(err.str().find("Unknown command: ad\nDid you mean 'add'?"), std::string::npos);
+}
+
+TEST_F(CliAppUnknownCommandTestSociable, HelpOnUnknownCommandIsOptIn)
+{
+    app->getConfig().helpOnUnknownCommand = true;
+    const std::vector<std::string_view> args{"xyz"};
+
+    app->run(args);
+
+    EXPECT_EQ(err.str().find("Did you mean"), std::string::npos);
+    EXPECT_NE(out.str().find("show the status"), std::string::npos);
+}
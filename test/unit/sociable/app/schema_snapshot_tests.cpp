@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cli_app.h"
+#include "commands/command.h"
+#include "commands/schema_snapshot.h"
+#include "logging/logger.h"
+
+using namespace cli;
+using namespace cli::commands;
+
+namespace
+{
+std::unique_ptr<CliApp> makeApp(int *executions = nullptr, bool withExtraOption = false,
+                                std::string_view depthValueName = "n")
+{
+    auto app = std::make_unique<CliApp>(CliConfig{},
+                                        std::make_unique<logging::Logger>(logging::LogLevel::ERROR));
+    Command remote("remote");
+    remote.withShortDescription("manage remotes").withLongDescription("Add and list remotes");
+    remote.withSubCommand(std::move(
+        Command("add")
+            .withShortDescription("add a remote")
+            .withPositionalArgument(PositionalArgument<std::string>("name"))
+            .withOptionArgument(OptionArgument<int>("--depth", depthValueName).withShortName("-d"))
+            .withExclusiveGroup(FlagArgument("--fetch", "-f"), FlagArgument("--no-fetch"))
+            .withExecutionFunc([executions](const CliContext &) {
+                if (executions)
+                    ++*executions;
+            })));
+    if (withExtraOption)
+    {
+        remote.withOptionArgument(OptionArgument<std::string>("--url", "url"));
+    }
+    app->withCommand(std::move(remote));
+    return app;
+}
+
+// turns the output of SchemaSnapshot::writeSource back into the bytes it encodes
+std::string decodeSource(const std::string &source)
+{
+    std::string bytes;
+    for (size_t pos = source.find('\\'); pos != std::string::npos; pos = source.find('\\', pos))
+    {
+        bytes.push_back(static_cast<char>((source[pos + 1] - '0') * 64 +
+                                          (source[pos + 2] - '0') * 8 + (source[pos + 3] - '0')));
+        pos += 4;
+    }
+    return bytes;
+}
+} // namespace
+
+TEST(SchemaSnapshotTest, SnapshotContainsTheSchema)
+{
+    auto app = makeApp();
+    const std::string blob = app->saveSchemaSnapshot();
+
+    const auto snapshot = SchemaSnapshot::load(blob);
+
+    const auto &commands = snapshot.getCommands();
+    ASSERT_EQ(commands.size(), 3u);
+    EXPECT_EQ(commands[0].parent, SchemaSnapshot::noParent);
+    EXPECT_EQ(commands[2].identifier, "add");
+    EXPECT_EQ(commands[2].parent, 1u);
+    ASSERT_EQ(commands[2].arguments.size(), 4u);
+    EXPECT_EQ(commands[2].arguments[1].name, "--depth");
+    EXPECT_EQ(commands[2].arguments[1].shortName, "-d");
+    EXPECT_EQ(commands[2].arguments[1].kind, ArgumentKind::Option);
+    EXPECT_TRUE(commands[2].arguments[0].required);
+    ASSERT_EQ(commands[2].groups.size(), 2u);
+    EXPECT_TRUE(commands[2].groups[1].exclusive);
+    EXPECT_EQ(commands[2].groups[1].members, (std::vector<uint32_t>{2, 3}));
+    EXPECT_EQ(commands[2].docStringLong, app->getMainCommand()
+                                             ->getSubCommand("remote")
+                                             ->getSubCommand("add")
+                                             ->getDocStringLong());
+}
+
+TEST(SchemaSnapshotTest, LoadedAppUsesTheRenderedHelpAndRuns)
+{
+    const std::string blob = makeApp()->saveSchemaSnapshot();
+    int executions = 0;
+    auto app = makeApp(&executions);
+
+    app->loadSchemaSnapshot(blob);
+
+    const auto snapshot = SchemaSnapshot::load(blob);
+    const std::string_view help =
+        app->getMainCommand()->getSubCommand("remote")->getDocStringShort();
+    EXPECT_EQ(help, snapshot.getCommands()[1].docStringShort);
+    // the help is a view into the blob, not a copy
+    EXPECT_GE(help.data(), blob.data());
+    EXPECT_LE(help.data() + help.size(), blob.data() + blob.size());
+    std::vector<std::string_view> args{"remote", "add", "origin", "-d", "1"};
+    app->run(args);
+    EXPECT_EQ(executions, 1);
+}
+
+TEST(SchemaSnapshotTest, SnapshotStoresTheSchemaHash)
+{
+    auto app = makeApp();
+    const std::string blob = app->saveSchemaSnapshot();
+
+    const auto header = SchemaSnapshot::loadHeader(blob);
+
+    EXPECT_EQ(header.getSchemaHash(),
+              SchemaSnapshot::schemaHash(app->getCommandTree(), app->getConfig()));
+    auto other = makeApp(nullptr, true);
+    EXPECT_NE(header.getSchemaHash(),
+              SchemaSnapshot::schemaHash(other->getCommandTree(), other->getConfig()));
+    ASSERT_EQ(header.getCommands().size(), 3u);
+    EXPECT_TRUE(header.getCommands()[2].path.ends_with("remote add"));
+    EXPECT_TRUE(header.getCommands()[2].arguments.empty());
+}
+
+TEST(SchemaSnapshotTest, LoadedAppSavesTheSameSnapshot)
+{
+    const std::string blob = makeApp()->saveSchemaSnapshot();
+    auto app = makeApp();
+
+    app->loadSchemaSnapshot(blob);
+
+    EXPECT_EQ(app->saveSchemaSnapshot(), blob);
+}
+
+TEST(SchemaSnapshotTest, MismatchingCommandsAreRejected)
+{
+    const std::string blob = makeApp()->saveSchemaSnapshot();
+    auto app = makeApp(nullptr, true);
+
+    EXPECT_THROW(app->loadSchemaSnapshot(blob), SchemaSnapshotException);
+}
+
+TEST(SchemaSnapshotTest, ChangedDescriptionsAreRejected)
+{
+    const std::string blob = makeApp()->saveSchemaSnapshot();
+    auto app = makeApp();
+    app->getMainCommand()->getSubCommand("remote")->withShortDescription("manage the remotes");
+
+    EXPECT_THROW(app->loadSchemaSnapshot(blob), SchemaSnapshotException);
+}
+
+TEST(SchemaSnapshotTest, ChangedHelpInputsAreRejected)
+{
+    const std::string blob = makeApp()->saveSchemaSnapshot();
+
+    auto renamedValue = makeApp(nullptr, false, "count");
+    auto wider = makeApp();
+    wider->getConfig().optionsWidth += 10;
+
+    EXPECT_THROW(renamedValue->loadSchemaSnapshot(blob), SchemaSnapshotException);
+    EXPECT_THROW(wider->loadSchemaSnapshot(blob), SchemaSnapshotException);
+}
+
+TEST(SchemaSnapshotTest, MalformedBlobsAreRejected)
+{
+    const std::string blob = makeApp()->saveSchemaSnapshot();
+
+    EXPECT_THROW(SchemaSnapshot::load("not a snapshot"), SchemaSnapshotException);
+    EXPECT_THROW(SchemaSnapshot::load(std::string_view(blob).substr(0, blob.size() - 1)),
+                 SchemaSnapshotException);
+    EXPECT_THROW(SchemaSnapshot::load(blob + "x"), SchemaSnapshotException);
+}
+
+TEST(SchemaSnapshotTest, SourceEmbedsTheBlob)
+{
+    const std::string blob = makeApp()->saveSchemaSnapshot();
+    std::ostringstream source;
+
+    SchemaSnapshot::writeSource(source, blob, "appSchema");
+
+    EXPECT_TRUE(source.str().starts_with("inline constexpr std::string_view appSchema{"));
+    EXPECT_EQ(decodeSource(source.str()), blob);
+}
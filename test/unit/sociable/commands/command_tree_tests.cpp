@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "commands/command.h"
+#include "commands/command_tree.h"
+
+using namespace cli::commands;
+
+class CommandTreeTestSociable : public ::testing::Test
+{
+public:
+    CommandTree tree{"app"};
+
+    void SetUp() override
+    {
+        tree.insert(std::make_unique<Command>("remote"));
+        tree.insert(std::make_unique<Command>("add"), "remote");
+        tree.insert(std::make_unique<Command>("remote"), "remote");
+        tree.insert(std::make_unique<Command>("branch"));
+        tree.insert(std::make_unique<Command>("list"), "branch");
+    }
+
+    // locates through the subcommand maps and the frozen flat tree and checks that they agree
+    void expectLocated(std::vector<std::string_view> args, const Command *expected,
+                       size_t expectedConsumed)
+    {
+        size_t consumed = 0;
+        EXPECT_EQ(tree.locate(args, consumed), expected);
+        EXPECT_EQ(consumed, expectedConsumed);
+
+        tree.freeze();
+        EXPECT_EQ(tree.locate(args, consumed), expected);
+        EXPECT_EQ(consumed, expectedConsumed);
+    }
+};
+
+TEST_F(CommandTreeTestSociable, LocatesLongestMatchingChain)
+{
+    expectLocated({"remote", "add", "origin"}, tree.find("remote", "add"), 2);
+}
+
+TEST_F(CommandTreeTestSociable, SameIdentifierOnDifferentLevelsIsResolvedByPrefix)
+{
+    expectLocated({"remote", "remote", "remote"}, tree.find("remote", "remote"), 2);
+}
+
+TEST_F(CommandTreeTestSociable, UnknownFirstIdentifierLocatesRoot)
+{
+    expectLocated({"list"}, tree.getRootCommand(), 0);
+}
+
+TEST_F(CommandTreeTestSociable, EmptyArgumentsLocateRoot)
+{
+    expectLocated({}, tree.getRootCommand(), 0);
+}
+
+TEST_F(CommandTreeTestSociable, InsertedCommandIsFoundAfterTreeWasFrozen)
+{
+    tree.freeze();
+
+    tree.insert(std::make_unique<Command>("all"), "branch", "list");
+
+    std::vector<std::string_view> args{"branch", "list", "all"};
+    size_t consumed = 0;
+    EXPECT_EQ(tree.locate(args, consumed), tree.find("branch", "list", "all"));
+    EXPECT_EQ(consumed, 3u);
+}
+
+TEST_F(CommandTreeTestSociable, SuggestsClosestSubCommands)
+{
+    tree.insert(std::make_unique<Command>("remove"), "remote");
+
+    EXPECT_EQ(tree.suggest(*tree.find("remote"), "remoe", 3),
+              (std::vector<std::string_view>{"remote", "remove"}));
+    EXPECT_EQ(tree.suggest(*tree.getRootCommand(), "brnch", 3),
+              (std::vector<std::string_view>{"branch"}));
+    EXPECT_TRUE(tree.suggest(*tree.getRootCommand(), "xyz", 3).empty());
+}
+
+TEST_F(CommandTreeTestSociable, SuggestionsSeeInsertedCommands)
+{
+    EXPECT_TRUE(tree.suggest(*tree.getRootCommand(), "stash", 3).empty());
+
+    tree.insert(std::make_unique<Command>("stash"));
+
+    EXPECT_EQ(tree.suggest(*tree.getRootCommand(), "stsh", 3),
+              (std::vector<std::string_view>{"stash"}));
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "commands/command.h"
+#include "commands/command_tree.h"
+#include "commands/completion.h"
+
+using namespace cli::commands;
+
+class CompleterTestSociable : public ::testing::Test
+{
+public:
+    CommandTree tree{"app"};
+
+    void SetUp() override
+    {
+        auto remote = std::make_unique<Command>("remote");
+        remote->withShortDescription("manage remotes");
+        tree.insert(std::move(remote));
+        tree.insert(std::make_unique<Command>("add"), "remote");
+        tree.insert(std::make_unique<Command>("remove"), "remote");
+        tree.insert(std::make_unique<Command>("rename"), "remote");
+        tree.insert(std::make_unique<Command>("branch"));
+
+        auto push = std::make_unique<Command>("push");
+        push->withPositionalArgument(PositionalArgument<std::string>("target"))
+            .withOptionArgument(OptionArgument<int>("--depth", "count", "-d", "history\tdepth"))
+            .withFlagArgument(FlagArgument("--force", "-f", "overwrite the remote"))
+            .withFlagArgument(FlagArgument("--dry-run"));
+        tree.insert(std::move(push), "remote");
+        tree.freeze();
+    }
+
+    std::vector<std::string> values(std::vector<std::string_view> words) const
+    {
+        std::vector<std::string> result;
+        for (const auto &candidate : Completer(tree).complete(words))
+        {
+            result.push_back(candidate.value);
+        }
+        return result;
+    }
+};
+
+TEST_F(CompleterTestSociable, CompletesSubCommandsByPrefix)
+{
+    EXPECT_EQ(values({""}), (std::vector<std::string>{"branch", "remote"}));
+    EXPECT_EQ(values({"re"}), (std::vector<std::string>{"remote"}));
+    EXPECT_EQ(values({"remote", "re"}), (std::vector<std::string>{"remove", "rename"}));
+    EXPECT_EQ(values({"remote", "x"}), (std::vector<std::string>{}));
+    EXPECT_EQ(values({}), (std::vector<std::string>{"branch", "remote"}));
+}
+
+TEST_F(CompleterTestSociable, SubCommandsCarryTheirShortDescription)
+{
+    const auto candidates = Completer(tree).complete(std::vector<std::string_view>{"rem"});
+
+    ASSERT_EQ(candidates.size(), 1);
+    EXPECT_EQ(candidates[0].description, "manage remotes");
+}
+
+TEST_F(CompleterTestSociable, CompletesOptionAndFlagNamesByPrefix)
+{
+    EXPECT_EQ(values({"remote", "push", "--d"}), (std::vector<std::string>{"--depth", "--dry-run"}));
+    EXPECT_EQ(values({"remote", "push", "-"}),
+              (std::vector<std::string>{"--depth", "--dry-run", "--force", "--help", "-d", "-f",
+                                        "-h"}));
+}
+
+TEST_F(CompleterTestSociable, SortedNamesAreBuiltOncePerCommand)
+{
+    const Command *push = tree.getRootCommand()->getSubCommand("remote")->getSubCommand("push");
+    const ArgumentIndex &index = push->getArgumentIndex();
+
+    const auto all = index.namesWithPrefix("");
+    const auto matches = index.namesWithPrefix("--d");
+
+    ASSERT_EQ(all.size(), 5);
+    ASSERT_EQ(matches.size(), 2);
+    EXPECT_EQ(matches.data(), all.data());
+    EXPECT_EQ(matches[1].name, "--dry-run");
+    EXPECT_EQ(matches[1].entry->kind, ArgumentKind::Flag);
+    EXPECT_TRUE(index.namesWithPrefix("--x").empty());
+    EXPECT_EQ(index.namesWithPrefix("-d").size(), 1);
+}
+
+TEST_F(CompleterTestSociable, OptionsAreDescribedByTheirValueName)
+{
+    const auto candidates =
+        Completer(tree).complete(std::vector<std::string_view>{"remote", "push", "--de"});
+
+    ASSERT_EQ(candidates.size(), 1);
+    EXPECT_EQ(candidates[0].description, "<count> history depth");
+}
+
+TEST_F(CompleterTestSociable, OffersNothingForTheValueOfAnOption)
+{
+    EXPECT_TRUE(values({"remote", "push", "--depth", ""}).empty());
+    EXPECT_TRUE(values({"remote", "push", "-d", "--"}).empty());
+}
+
+TEST_F(CompleterTestSociable, OffersNoSubCommandsOrHelpAfterArguments)
+{
+    EXPECT_TRUE(values({"remote", "push", "origin", ""}).empty());
+    EXPECT_EQ(values({"remote", "push", "origin", "--f"}), (std::vector<std::string>{"--force"}));
+    EXPECT_TRUE(values({"remote", "push", "origin", "--h"}).empty());
+}
+
+TEST_F(CompleterTestSociable, WritesOneTabSeparatedLinePerCandidate)
+{
+    std::ostringstream out;
+
+    Completer::writeCandidates(
+        out, Completer(tree).complete(std::vector<std::string_view>{"remote", "push", "-f"}));
+
+    EXPECT_EQ(out.str(), "-f\toverwrite the remote\n");
+}
+
+TEST(CompleterScriptTest, WritesScriptsForSupportedShells)
+{
+    for (const std::string_view shell : {"bash", "zsh", "fish"})
+    {
+        std::ostringstream out;
+        Completer::writeScript(out, shell, "/usr/bin/my-tool");
+
+        EXPECT_NE(out.str().find("/usr/bin/my-tool __complete -- "), std::string::npos) << shell;
+        EXPECT_NE(out.str().find("_my_tool_complete"), std::string::npos) << shell;
+    }
+}
+
+TEST(CompleterScriptTest, ThrowsForUnsupportedShell)
+{
+    std::ostringstream out;
+    EXPECT_THROW(Completer::writeScript(out, "powershell", "tool"), UnsupportedShellException);
+}
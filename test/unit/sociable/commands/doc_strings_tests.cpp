@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cli_app.h"
+#include "commands/command.h"
+#include "commands/docwriting/docformatter.h"
+#include "commands/docwriting/docs_exception.h"
+#include "logging/logger.h"
+
+using namespace cli;
+using namespace cli::commands;
+
+namespace
+{
+struct RenderCounts
+{
+    std::atomic<int> longDocs{0};
+    std::atomic<int> shortDocs{0};
+};
+
+class CountingCommandFormatter : public docwriting::DefaultCommandFormatter
+{
+public:
+    explicit CountingCommandFormatter(RenderCounts &counts) : counts(counts) {}
+
+    std::string generateLongDocString(const Command &command, std::string_view fullCommandPath,
+                                      const docwriting::DocWriter &writer,
+                                      const CliConfig &configuration) const override
+    {
+        ++counts.longDocs;
+        return DefaultCommandFormatter::generateLongDocString(command, fullCommandPath, writer,
+                                                              configuration);
+    }
+
+    std::string generateShortDocString(const Command &command, std::string_view fullCommandPath,
+                                       const docwriting::DocWriter &writer,
+                                       const CliConfig &configuration) const override
+    {
+        ++counts.shortDocs;
+        return DefaultCommandFormatter::generateShortDocString(command, fullCommandPath, writer,
+                                                               configuration);
+    }
+
+private:
+    RenderCounts &counts;
+};
+std::unique_ptr<CliApp> makeLargeApp(unsigned threads)
+{
+    CliConfig config;
+    config.eagerDocStrings = true;
+    config.docRenderingThreads = threads;
+    auto app = std::make_unique<CliApp>(config,
+                                        std::make_unique<logging::Logger>(logging::LogLevel::ERROR));
+    for (int i = 0; i < 40; ++i)
+    {
+        Command group("group" + std::to_string(i));
+        group.withShortDescription("a group of commands");
+        for (int j = 0; j < 10; ++j)
+        {
+            group.withSubCommand(std::move(
+                Command("cmd" + std::to_string(j))
+                    .withLongDescription("does something with " + std::to_string(j))
+                    .withPositionalArgument(PositionalArgument<std::string>("file"))
+                    .withOptionArgument(OptionArgument<int>("--level", "n").withShortName("-l"))
+                    .withFlagArgument(FlagArgument("--verbose", "-v"))
+                    .withExecutionFunc([](const CliContext &) {})));
+        }
+        app->withCommand(std::move(group));
+    }
+    return app;
+}
+} // namespace
+
+class DocStringsTestSociable : public ::testing::Test
+{
+public:
+    CliApp app{CliConfig{}, std::make_unique<logging::Logger>(logging::LogLevel::ERROR)};
+    RenderCounts counts;
+
+    void SetUp() override
+    {
+        app.getDocWriter().setCommandFormatter(std::make_unique<CountingCommandFormatter>(counts));
+        for (int i = 0; i < 50; ++i)
+        {
+            app.withCommand(std::move(Command("cmd" + std::to_string(i))
+                                          .withShortDescription("a command")
+                                          .withExecutionFunc([](const CliContext &) {})));
+        }
+    }
+};
+
+TEST_F(DocStringsTestSociable, InitDoesNotRenderDocStrings)
+{
+    app.init();
+
+    EXPECT_EQ(counts.longDocs, 0);
+    EXPECT_EQ(counts.shortDocs, 0);
+}
+
+TEST_F(DocStringsTestSociable, DocStringsAreRenderedOnceOnFirstAccess)
+{
+    app.init();
+    const Command *cmd = app.getMainCommand()->getSubCommand("cmd7");
+
+    const std::string first(cmd->getDocStringLong());
+    const std::string second(cmd->getDocStringLong());
+
+    EXPECT_FALSE(first.empty());
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(counts.longDocs, 1);
+    EXPECT_EQ(counts.shortDocs, 0);
+}
+
+TEST_F(DocStringsTestSociable, CommandHelpOnlyRendersTheRequestedCommand)
+{
+    std::vector<std::string_view> args{"cmd3", "--help"};
+
+    app.run(args);
+
+    EXPECT_EQ(counts.longDocs, 1);
+}
+
+TEST(DocStringsTest, UnboundCommandWithoutDocStringsThrows)
+{
+    Command cmd("cmd");
+
+    EXPECT_THROW((void)cmd.getDocStringShort(), docwriting::DocsNotBuildException);
+}
+
+TEST_F(DocStringsTestSociable, EagerRenderingRendersEveryCommandInInit)
+{
+    app.getConfig().eagerDocStrings = true;
+    app.getConfig().docRenderingThreads = 4;
+
+    app.init();
+
+    // the root command is rendered as well
+    EXPECT_EQ(counts.longDocs, 51);
+    EXPECT_EQ(counts.shortDocs, 51);
+}
+
+TEST(DocStringsTest, ParallelRenderingMatchesSequentialRendering)
+{
+    auto sequential = makeLargeApp(1);
+    auto parallel = makeLargeApp(8);
+
+    sequential->init();
+    parallel->init();
+
+    const auto expected = sequential->getCommandTree().getAllCommandsConst();
+    const auto actual = parallel->getCommandTree().getAllCommandsConst();
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(actual[i]->getDocStringLong(), expected[i]->getDocStringLong());
+        EXPECT_EQ(actual[i]->getDocStringShort(), expected[i]->getDocStringShort());
+    }
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "commands/command.h"
+#include "commands/command_tree.h"
+#include "commands/flat_command_tree.h"
+
+using namespace cli::commands;
+
+class FlatCommandTreeTestSociable : public ::testing::Test
+{
+public:
+    CommandTree tree{"app"};
+
+    void SetUp() override
+    {
+        tree.insert(std::make_unique<Command>("remote"));
+        tree.insert(std::make_unique<Command>("add"), "remote");
+        tree.insert(std::make_unique<Command>("remove"), "remote");
+        tree.insert(std::make_unique<Command>("branch"));
+        tree.insert(std::make_unique<Command>("list"), "branch");
+        tree.insert(std::make_unique<Command>("all"), "branch", "list");
+    }
+
+    static std::vector<std::string> identifiers(const std::vector<Command *> &commands)
+    {
+        std::vector<std::string> ids;
+        for (const auto *cmd : commands)
+        {
+            ids.emplace_back(cmd->getIdentifier());
+        }
+        return ids;
+    }
+};
+
+TEST_F(FlatCommandTreeTestSociable, TraversalOrderMatchesTheNestedTree)
+{
+    const auto nested = identifiers(tree.getAllCommands());
+
+    tree.freeze();
+
+    EXPECT_TRUE(tree.isFrozen());
+    EXPECT_EQ(identifiers(tree.getAllCommands()), nested);
+    EXPECT_EQ(nested, (std::vector<std::string>{"app", "branch", "list", "all", "remote", "add",
+                                                "remove"}));
+}
+
+TEST_F(FlatCommandTreeTestSociable, IdentifiersAreStoredInThePool)
+{
+    tree.freeze();
+    const auto &flat = tree.getFlatTree();
+
+    ASSERT_EQ(flat.size(), 7u);
+    for (size_t i = 0; i < flat.size(); ++i)
+    {
+        EXPECT_EQ(flat.identifierAt(i), flat.commandAt(i)->getIdentifier());
+        EXPECT_NE(flat.identifierAt(i).data(), flat.commandAt(i)->getIdentifier().data());
+    }
+}
+
+TEST_F(FlatCommandTreeTestSociable, ChildrenAreFoundByIdentifier)
+{
+    tree.freeze();
+    const auto &flat = tree.getFlatTree();
+
+    const size_t remote = flat.findChild(0, "remote");
+    ASSERT_NE(remote, FlatCommandTree::npos);
+    EXPECT_EQ(flat.commandAt(remote), tree.find("remote"));
+    EXPECT_EQ(flat.commandAt(flat.findChild(remote, "remove")), tree.find("remote", "remove"));
+    EXPECT_EQ(flat.findChild(remote, "rem"), FlatCommandTree::npos);
+    EXPECT_EQ(flat.findChild(0, "add"), FlatCommandTree::npos);
+}
+
+TEST_F(FlatCommandTreeTestSociable, LocateConsumesMatchingIdentifiers)
+{
+    tree.freeze();
+    const auto &flat = tree.getFlatTree();
+    std::vector<std::string_view> args{"branch", "list", "all", "--force", "remote"};
+    size_t consumed = 0;
+
+    const size_t located = flat.locate(args, consumed);
+
+    EXPECT_EQ(consumed, 3u);
+    EXPECT_EQ(flat.commandAt(located), tree.find("branch", "list", "all"));
+}
+
+TEST_F(FlatCommandTreeTestSociable, LocateWithoutMatchReturnsRoot)
+{
+    tree.freeze();
+    std::vector<std::string_view> args{"unknown"};
+    size_t consumed = 1;
+
+    EXPECT_EQ(tree.getFlatTree().locate(args, consumed), 0u);
+    EXPECT_EQ(consumed, 0u);
+}
+
+TEST_F(FlatCommandTreeTestSociable, InsertDiscardsTheFlatTree)
+{
+    tree.freeze();
+
+    tree.insert(std::make_unique<Command>("tag"));
+
+    EXPECT_FALSE(tree.isFrozen());
+    EXPECT_EQ(tree.getAllCommands().size(), 8u);
+}
+
+TEST(FlatCommandTreeEdgeTestSociable, RootWithoutSubCommandsIsBuilt)
+{
+    CommandTree tree{"app"};
+    tree.freeze();
+    std::vector<std::string_view> args{"anything"};
+    size_t consumed = 1;
+
+    EXPECT_TRUE(tree.isFrozen());
+    EXPECT_EQ(tree.locate(args, consumed), tree.getRootCommand());
+    EXPECT_EQ(consumed, 0u);
+}
+
+TEST(FlatCommandTreeEdgeTestSociable, FindsEveryChildOfWideAndDeepTrees)
+{
+    CommandTree tree{"app"};
+    for (int i = 0; i < 500; ++i)
+    {
+        const std::string id = "cmd" + std::to_string(i);
+        tree.insert(std::make_unique<Command>(id));
+        tree.insert(std::make_unique<Command>(id), id); // same identifier one level deeper
+    }
+    tree.freeze();
+    const auto &flat = tree.getFlatTree();
+
+    for (int i = 0; i < 500; ++i)
+    {
+        const std::string id = "cmd" + std::to_string(i);
+        const size_t child = flat.findChild(0, id);
+        ASSERT_NE(child, FlatCommandTree::npos);
+        EXPECT_EQ(flat.commandAt(child), tree.find(id));
+        EXPECT_EQ(flat.commandAt(flat.findChild(child, id)), tree.find(id, id));
+    }
+    EXPECT_EQ(flat.findChild(0, "cmd500"), FlatCommandTree::npos);
+}
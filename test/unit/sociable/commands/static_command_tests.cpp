@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cli_app.h"
+#include "commands/static_command.h"
+#include "logging/logger.h"
+#include "parsing/parse_exception.h"
+
+using namespace cli;
+using namespace cli::commands;
+
+using BuildCommand = StaticCommand<"build", schema::Positional<std::string_view, "target">,
+                                   schema::Option<int, "--jobs", "-j">,
+                                   schema::Option<double, "--ratio">,
+                                   schema::Flag<"--verbose", "-v">>;
+
+class StaticCommandTestSociable : public ::testing::Test
+{
+public:
+    BuildCommand command;
+
+    BuildCommand::Result parse(const std::vector<std::string_view> &inputs) const
+    {
+        return command.parse(inputs);
+    }
+};
+
+TEST_F(StaticCommandTestSociable, ParsesIntoTypedResult)
+{
+    auto result = parse({"app", "-j", "8", "--verbose"});
+
+    EXPECT_EQ(result.get<"target">(), "app");
+    EXPECT_EQ(result.get<"--jobs">(), 8);
+    EXPECT_EQ(result.get<"--ratio">(), std::nullopt);
+    EXPECT_TRUE(result.get<"--verbose">());
+}
+
+TEST_F(StaticCommandTestSociable, ResultSupportsStructuredBindings)
+{
+    const auto &[target, jobs, ratio, verbose] = parse({"--ratio", "0.5", "lib"}).asTuple();
+
+    EXPECT_EQ(target, "lib");
+    EXPECT_FALSE(jobs.has_value());
+    EXPECT_DOUBLE_EQ(ratio.value(), 0.5);
+    EXPECT_FALSE(verbose);
+}
+
+TEST_F(StaticCommandTestSociable, InvalidInputsThrow)
+{
+    EXPECT_THROW(parse({"app", "--jobs"}), parsing::ParseException);
+    EXPECT_THROW(parse({"app", "-j", "1", "-j", "2"}), parsing::ParseException);
+    EXPECT_THROW(parse({"app", "-j", "many"}), parsing::TypeParseException);
+    EXPECT_THROW(parse({"app", "other"}), parsing::UnknownInputException);
+    EXPECT_THROW(parse({"-v"}), parsing::ParseException);
+}
+
+TEST_F(StaticCommandTestSociable, MistypedOptionIsReportedAsUnknownWithSuggestion)
+{
+    try
+    {
+        (void)parse({"app", "--jbos", "2"});
+        FAIL() << "Expected an UnknownInputException";
+    }
+    catch (const parsing::UnknownInputException &e)
+    {
+        const std::string message = e.what();
+        EXPECT_TRUE(message.starts_with("Unknown argument: --jbos")) << message;
+        EXPECT_NE(message.find("--jobs"), std::string::npos) << message;
+    }
+}
+
+TEST_F(StaticCommandTestSociable, ExtraPositionalIsReportedAsSuch)
+{
+    try
+    {
+        (void)parse({"app", "other"});
+        FAIL() << "Expected an UnknownInputException";
+    }
+    catch (const parsing::UnknownInputException &e)
+    {
+        EXPECT_TRUE(std::string_view(e.what()).starts_with("More positional arguments"))
+            << e.what();
+    }
+}
+
+TEST(StaticCommandWithoutPositionalsTestSociable, AnyUnmatchedInputIsUnknown)
+{
+    StaticCommand<"clean", schema::Flag<"--all", "-a">> command;
+
+    try
+    {
+        (void)command.parse(std::vector<std::string_view>{"all"});
+        FAIL() << "Expected an UnknownInputException";
+    }
+    catch (const parsing::UnknownInputException &e)
+    {
+        EXPECT_TRUE(std::string_view(e.what()).starts_with("Unknown argument: all")) << e.what();
+    }
+}
+
+TEST_F(StaticCommandTestSociable, SchemaIsRegisteredAsRegularArguments)
+{
+    const auto &index = command.getArgumentIndex();
+
+    ASSERT_EQ(index.slotCount(), 4);
+    EXPECT_EQ(index.findSlot("target"), 0);
+    EXPECT_EQ(index.findSlot("-j"), 1);
+    EXPECT_EQ(index.findSlot("--ratio"), 2);
+    EXPECT_EQ(index.findSlot("-v"), 3);
+}
+
+TEST(StaticCommandAppTestSociable, IsDispatchedAsSubcommand)
+{
+    std::optional<int> jobs;
+    bool verbose = false;
+
+    CliConfig config;
+    config.executableName = "tool";
+    CliApp app(config, std::make_unique<logging::Logger>(logging::LogLevel::ERROR));
+    auto parent = std::make_unique<Command>("project");
+    parent->withSubCommand(
+        std::make_unique<BuildCommand>([&](const BuildCommand::Result &result, auto &) {
+            jobs = result.get<"--jobs">();
+            verbose = result.get<"--verbose">();
+        }));
+    app.withCommand(std::move(parent));
+
+    std::vector<std::string_view> args{"project", "build", "app", "--jobs", "4", "-v"};
+    app.run(args);
+
+    EXPECT_EQ(jobs, 4);
+    EXPECT_TRUE(verbose);
+}
+
+TEST(StaticCommandAppTestSociable, CanBeExecutedWithContext)
+{
+    std::optional<int> jobs;
+    BuildCommand command([&](const BuildCommand::Result &result, auto &) {
+        jobs = result.get<"--jobs">();
+    });
+
+    CliConfig config;
+    parsing::Parser parser(config);
+    logging::Logger logger(logging::LogLevel::ERROR);
+    ContextBuilder builder;
+    std::vector<std::string> inputs{"app", "-j", "3"};
+    parser.parseArguments(command, inputs, builder);
+    command.execute(*builder.build(logger));
+
+    EXPECT_EQ(jobs, 3);
+}
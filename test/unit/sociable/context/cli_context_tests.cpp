@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <any>
+#include <string>
+#include <vector>
+
+#include "cli_context.h"
+#include "commands/command.h"
+#include "context_builder.h"
+#include "context_exception.h"
+#include "logging/logger.h"
+
+using namespace cli;
+using namespace cli::commands;
+
+class CliContextTestSociable : public ::testing::Test
+{
+public:
+    logging::Logger logger{logging::LogLevel::ERROR};
+    Command command{"cmd"};
+
+    void SetUp() override
+    {
+        command.withOptionArgument(OptionArgument<int>("--threads", "count").withShortName("-t"))
+            .withPositionalArgument(PositionalArgument<std::string>("file"))
+            .withFlagArgument(FlagArgument("--verbose", "-v"))
+            .withOptionArgument(
+                OptionArgument<int>("--ids", "id").withShortName("-i").withRepeatable(true));
+    }
+};
+
+TEST_F(CliContextTestSociable, SlotsFollowDeclarationOrder)
+{
+    const auto &index = command.getArgumentIndex();
+
+    ASSERT_EQ(index.slotCount(), 4);
+    EXPECT_EQ(index.findSlot("--threads"), 0);
+    EXPECT_EQ(index.findSlot("-t"), 0);
+    EXPECT_EQ(index.findSlot("file"), 1);
+    EXPECT_EQ(index.findSlot("-v"), 2);
+    EXPECT_EQ(index.findSlot("--ids"), 3);
+    EXPECT_EQ(index.positionalSlot(0), 1);
+    EXPECT_EQ(index.findSlot("--unknown"), ArgumentIndex::npos);
+}
+
+TEST_F(CliContextTestSociable, NameBasedAccessorsResolveSlots)
+{
+    ContextBuilder builder(command.getArgumentIndex());
+    std::any threads = 4;
+    std::any file = std::string("input.txt");
+    builder.addOptionArgument(std::string("--threads"), threads)
+        .addPositionalArgument(std::string("file"), file)
+        .addFlagArgument(std::string("--verbose"))
+        .addRepeatableOptionArgument(std::string("--ids"), std::vector<std::any>{1, 2})
+        .addRepeatableOptionArgument(std::string("--ids"), std::vector<std::any>{3});
+    auto ctx = builder.build(logger);
+
+    EXPECT_EQ(ctx->getOptionArg<int>("--threads"), 4);
+    EXPECT_EQ(ctx->getOptionArg<int>("-t"), 4);
+    EXPECT_EQ(ctx->getPositionalArg<std::string>("file"), "input.txt");
+    EXPECT_EQ(ctx->getArg<std::string>("file"), "input.txt");
+    EXPECT_TRUE(ctx->isFlagPresent("-v"));
+    EXPECT_TRUE(ctx->isArgPresent("--verbose"));
+    EXPECT_EQ(ctx->getRepeatableOptionArg<int>("--ids"), (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(ctx->getRepeatableArg<int>("--ids"), (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(CliContextTestSociable, AccessorsOnlyMatchTheirArgumentKind)
+{
+    ContextBuilder builder(command.getArgumentIndex());
+    builder.setValue(command.getArgumentIndex().findSlot("file"), std::string("input.txt"));
+    auto ctx = builder.build(logger);
+
+    EXPECT_TRUE(ctx->isPositionalArgPresent("file"));
+    EXPECT_FALSE(ctx->isOptionArgPresent("file"));
+    EXPECT_FALSE(ctx->isFlagPresent("file"));
+    EXPECT_THROW(ctx->getOptionArg<std::string>("file"), MissingArgumentException);
+}
+
+TEST_F(CliContextTestSociable, MissingArgumentThrows)
+{
+    ContextBuilder builder(command.getArgumentIndex());
+    auto ctx = builder.build(logger);
+
+    EXPECT_FALSE(ctx->isArgPresent("--threads"));
+    EXPECT_THROW(ctx->getOptionArg<int>("--threads"), MissingArgumentException);
+    EXPECT_THROW(ctx->getOptionArg<int>("--unknown"), MissingArgumentException);
+}
+
+TEST_F(CliContextTestSociable, WrongTypeThrows)
+{
+    ContextBuilder builder(command.getArgumentIndex());
+    builder.setValue(command.getArgumentIndex().findSlot("--threads"), 4);
+    auto ctx = builder.build(logger);
+
+    EXPECT_THROW(ctx->getOptionArg<std::string>("--threads"), InvalidArgumentTypeException);
+    EXPECT_THROW(ctx->getRepeatableOptionArg<int>("--threads"), InvalidArgumentTypeException);
+}
+
+TEST_F(CliContextTestSociable, UnknownNameIsRejectedByBuilder)
+{
+    ContextBuilder builder(command.getArgumentIndex());
+
+    EXPECT_THROW(builder.addFlagArgument(std::string("--unknown")), std::invalid_argument);
+}
+
+TEST_F(CliContextTestSociable, UnboundBuilderAcceptsAnyName)
+{
+    ContextBuilder builder;
+    std::any threads = 4;
+    std::any file = std::string("input.txt");
+    builder.addOptionArgument(std::string("--threads"), threads)
+        .addPositionalArgument(std::string("file"), file)
+        .addFlagArgument(std::string("--verbose"))
+        .addRepeatableOptionArgument(std::string("--ids"), std::vector<std::any>{1, 2})
+        .addRepeatableOptionArgument(std::string("--ids"), std::vector<std::any>{3});
+    EXPECT_TRUE(builder.isArgPresent("--verbose"));
+    auto ctx = builder.build(logger);
+
+    EXPECT_EQ(ctx->getOptionArg<int>("--threads"), 4);
+    EXPECT_EQ(ctx->getPositionalArg<std::string>("file"), "input.txt");
+    EXPECT_TRUE(ctx->isFlagPresent("--verbose"));
+    EXPECT_FALSE(ctx->isOptionArgPresent("--verbose"));
+    EXPECT_EQ(ctx->getRepeatableOptionArg<int>("--ids"), (std::vector<int>{1, 2, 3}));
+    EXPECT_THROW(ctx->getOptionArg<int>("--unknown"), MissingArgumentException);
+    EXPECT_THROW(ctx->getOptionArg<std::string>("--threads"), InvalidArgumentTypeException);
+}
+
+TEST_F(CliContextTestSociable, UnboundBuilderRejectsNameAddedAsOtherKind)
+{
+    ContextBuilder builder;
+    builder.addFlagArgument(std::string("--verbose"));
+    std::any value = 1;
+
+    EXPECT_THROW(builder.addOptionArgument(std::string("--verbose"), value),
+                 std::invalid_argument);
+}
+
+TEST(CliContextHandleTestSociable, HandlesLoadValuesBySlot)
+{
+    logging::Logger logger{logging::LogLevel::ERROR};
+    ArgHandle<int> threads;
+    ArgHandle<std::string> file;
+    ArgHandle<int> ids;
+    FlagHandle verbose;
+    FlagHandle dryRun;
+    Command command("cmd");
+    command.withOptionArgument(OptionArgument<int>("--threads", "count"), threads)
+        .withPositionalArgument(PositionalArgument<std::string>("file"), file)
+        .withFlagArgument(FlagArgument("--verbose", "-v"), verbose)
+        .withOptionArgument(OptionArgument<int>("--ids", "id").withRepeatable(true), ids)
+        .withFlagArgument(FlagArgument("--dry-run"), dryRun);
+
+    ContextBuilder builder(command.getArgumentIndex());
+    builder.setValue(threads.getSlot(), 4)
+        .setValue(file.getSlot(), std::string("input.txt"))
+        .appendValues(ids.getSlot(), {1, 2})
+        .setFlag(verbose.getSlot());
+    auto ctx = builder.build(logger);
+
+    EXPECT_EQ(ctx->get(threads), 4);
+    EXPECT_EQ(ctx->get(file), "input.txt");
+    EXPECT_EQ(ctx->getRepeatable(ids), (std::vector<int>{1, 2}));
+    EXPECT_TRUE(ctx->get(verbose));
+    EXPECT_FALSE(ctx->get(dryRun));
+    EXPECT_EQ(ctx->getOptionArg<int>("--threads"), ctx->get(threads));
+}
+
+TEST(CliContextHandleTestSociable, MissingOrInvalidHandleThrows)
+{
+    logging::Logger logger{logging::LogLevel::ERROR};
+    ArgHandle<int> threads;
+    ArgHandle<int> unset;
+    Command command("cmd");
+    command.withOptionArgument(OptionArgument<int>("--threads", "count"), threads);
+
+    ContextBuilder builder(command.getArgumentIndex());
+    auto ctx = builder.build(logger);
+
+    EXPECT_TRUE(threads.isValid());
+    EXPECT_FALSE(unset.isValid());
+    EXPECT_FALSE(ctx->isPresent(threads));
+    EXPECT_THROW(ctx->get(threads), MissingArgumentException);
+    EXPECT_THROW(ctx->get(unset), MissingArgumentException);
+}
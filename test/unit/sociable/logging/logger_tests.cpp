@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <cstdio>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "logging/formatter.h"
 #include "logging/handler.h"
@@ -86,6 +90,44 @@ TEST_F(LoggerTestSociable, RemoveAllHandlersPreventsEmits)
     EXPECT_TRUE(err.str().empty());
 }
 
+TEST_F(LoggerTestSociable, StreamsFromManyThreadsDoNotInterleave)
+{
+    constexpr int threadCount = 4;
+    constexpr int perThread = 200;
+
+    Logger logger(LogLevel::TRACE);
+    logger.removeAllHandlers();
+    logger.addHandler(std::make_unique<BaseHandler>(
+        out, err, std::make_unique<MessageOnlyFormatter>(), LogLevel::TRACE));
+    {
+        std::vector<std::jthread> writers;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            writers.emplace_back([&logger, t] {
+                for (int i = 0; i < perThread; ++i)
+                {
+                    logger.info() << "thread " << t << " message " << i << std::flush;
+                }
+            });
+        }
+    }
+
+    std::istringstream lines(out.str());
+    std::vector<int> nextMessage(threadCount, 0);
+    std::string line;
+    int count = 0;
+    while (std::getline(lines, line))
+    {
+        int t = -1;
+        int i = -1;
+        ASSERT_EQ(std::sscanf(line.c_str(), "thread %d message %d", &t, &i), 2) << line;
+        ASSERT_TRUE(t >= 0 && t < threadCount) << line;
+        EXPECT_EQ(i, nextMessage[t]++); // messages of one thread keep their order
+        ++count;
+    }
+    EXPECT_EQ(count, threadCount * perThread);
+}
+
 struct LoggerMethodCase
 {
     LogLevel level;
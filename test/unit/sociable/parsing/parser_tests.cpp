@@ -0,0 +1,323 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "cli_config.h"
+#include "commands/command.h"
+#include "context_builder.h"
+#include "logging/logger.h"
+#include "parsing/parse_exception.h"
+#include "parsing/parser.h"
+
+using namespace cli;
+using namespace cli::commands;
+
+class ParserTestSociable : public ::testing::Test
+{
+public:
+    CliConfig config;
+    parsing::Parser parser{config};
+    logging::Logger logger{logging::LogLevel::ERROR};
+    Command command{"cmd"};
+
+    void SetUp() override
+    {
+        command.withPositionalArgument(PositionalArgument<std::string>("file").withRequired(false))
+            .withOptionArgument(OptionArgument<int>("--threads", "count").withShortName("-t"))
+            .withOptionArgument(
+                OptionArgument<int>("--ids", "id").withShortName("-i").withRepeatable(true))
+            .withFlagArgument(FlagArgument("--verbose", "-v"));
+    }
+
+    std::unique_ptr<CliContext> parse(const std::vector<std::string> &inputs)
+    {
+        ContextBuilder builder;
+        parser.parseArguments(command, inputs, builder);
+        return builder.build(logger);
+    }
+};
+
+TEST_F(ParserTestSociable, OptionIsMatchedByLongName)
+{
+    auto ctx = parse({"--threads", "4"});
+
+    EXPECT_EQ(ctx->getOptionArg<int>("--threads"), 4);
+}
+
+TEST_F(ParserTestSociable, OptionIsMatchedByShortName)
+{
+    auto ctx = parse({"-t", "8"});
+
+    EXPECT_EQ(ctx->getOptionArg<int>("--threads"), 8);
+}
+
+TEST_F(ParserTestSociable, FlagIsMatchedByBothNames)
+{
+    auto ctx = parse({"-v"});
+
+    EXPECT_TRUE(ctx->isFlagPresent("--verbose"));
+    EXPECT_TRUE(ctx->isFlagPresent("-v"));
+}
+
+TEST_F(ParserTestSociable, UnknownTokenIsTreatedAsPositional)
+{
+    auto ctx = parse({"--unknown"});
+
+    EXPECT_EQ(ctx->getPositionalArg<std::string>("file"), "--unknown");
+    EXPECT_FALSE(ctx->isOptionArgPresent("--threads"));
+}
+
+TEST_F(ParserTestSociable, RepeatedOptionValuesAreAppended)
+{
+    auto ctx = parse({"--ids", "1,2", "-i", "3"});
+
+    EXPECT_EQ(ctx->getRepeatableOptionArg<int>("--ids"), (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(ParserTestSociable, RepeatableListIsTrimmedAndSkipsEmptyValues)
+{
+    auto ctx = parse({"--ids", " 1 ,,\t2 , 3,"});
+
+    EXPECT_EQ(ctx->getRepeatableOptionArg<int>("--ids"), (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(ParserTestSociable, OptionWithoutValueThrows)
+{
+    EXPECT_THROW(parse({"--threads"}), parsing::ParseException);
+}
+
+TEST_F(ParserTestSociable, ViewsOfArgvAreParsedWithoutCopies)
+{
+    std::string_view inputs[] = {"-t", "2", "input.txt"};
+    ContextBuilder builder;
+
+    parser.parseArguments(command, inputs, builder);
+    auto ctx = builder.build(logger);
+
+    EXPECT_EQ(ctx->getOptionArg<int>("--threads"), 2);
+    EXPECT_EQ(ctx->getPositionalArg<std::string>("file"), "input.txt");
+}
+
+TEST_F(ParserTestSociable, NonRepeatableOptionCannotBeRepeated)
+{
+    EXPECT_THROW(parse({"--threads", "1", "-t", "2"}), parsing::ParseException);
+}
+
+TEST_F(ParserTestSociable, ArgumentsAddedAfterLookupAreFound)
+{
+    parse({"--threads", "1"});
+    command.withFlagArgument(FlagArgument("--dry-run", "-n"));
+
+    auto ctx = parse({"-n"});
+
+    EXPECT_TRUE(ctx->isFlagPresent("--dry-run"));
+}
+
+TEST_F(ParserTestSociable, ManyOptionsAreAllResolvable)
+{
+    Command wide("wide");
+    for (int i = 0; i < 200; ++i)
+    {
+        wide.withOptionArgument(OptionArgument<int>("--opt" + std::to_string(i), "value")
+                                    .withShortName("-o" + std::to_string(i)));
+    }
+    wide.buildArgumentIndex();
+
+    ContextBuilder builder;
+    parser.parseArguments(wide, {"--opt150", "150", "-o7", "7"}, builder);
+    auto ctx = builder.build(logger);
+
+    EXPECT_EQ(ctx->getOptionArg<int>("--opt150"), 150);
+    EXPECT_EQ(ctx->getOptionArg<int>("--opt7"), 7);
+}
+
+TEST_F(ParserTestSociable, LazyConversionDefersTypeErrorsToAccess)
+{
+    config.lazyConversion = true;
+    const std::vector<std::string> inputs{"--threads", "many", "input.txt"};
+
+    auto ctx = parse(inputs);
+
+    EXPECT_EQ(ctx->getPositionalArg<std::string>("file"), "input.txt");
+    EXPECT_THROW(ctx->getOptionArg<int>("--threads"), parsing::TypeParseException);
+}
+
+TEST_F(ParserTestSociable, LazyConversionReturnsTheSameValueOnRepeatedAccess)
+{
+    config.lazyConversion = true;
+    ArgHandle<int> level;
+    Command lazy("lazy");
+    lazy.withOptionArgument(OptionArgument<int>("--level", "n"), level);
+    const std::vector<std::string> inputs{"--level", "4"};
+    ContextBuilder builder;
+
+    parser.parseArguments(lazy, inputs, builder);
+    auto ctx = builder.build(logger);
+
+    const int &first = ctx->get(level);
+    const int &second = ctx->get(level);
+    EXPECT_EQ(first, 4);
+    EXPECT_EQ(&first, &second);
+}
+
+TEST_F(ParserTestSociable, LazyConversionResolvesRepeatableValues)
+{
+    config.lazyConversion = true;
+    const std::vector<std::string> inputs{"--ids", "1,2", "-i", "3"};
+
+    auto ctx = parse(inputs);
+
+    EXPECT_EQ(ctx->getRepeatableOptionArg<int>("--ids"), (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(ParserTestSociable, EagerConversionFailsWhileParsing)
+{
+    const std::vector<std::string> inputs{"--threads", "many"};
+
+    EXPECT_THROW(parse(inputs), parsing::TypeParseException);
+}
+
+TEST_F(ParserTestSociable, MistypedOptionSuggestsClosestNames)
+{
+    try
+    {
+        parse({"file.txt", "--verbos"});
+        FAIL() << "Expected an UnknownInputException";
+    }
+    catch (const parsing::UnknownInputException &e)
+    {
+        EXPECT_STREQ(e.what(), "Unknown argument: --verbos. Did you mean '--verbose'?");
+        EXPECT_EQ(e.getInput(), "--verbos");
+    }
+}
+
+TEST_F(ParserTestSociable, SuggestionsCanBeDisabled)
+{
+    config.suggestionLimit = 0;
+
+    try
+    {
+        parse({"file.txt", "--thread", "2"});
+        FAIL() << "Expected an UnknownInputException";
+    }
+    catch (const parsing::UnknownInputException &e)
+    {
+        EXPECT_STREQ(e.what(), "Unknown argument: --thread");
+    }
+}
+
+TEST_F(ParserTestSociable, InputForCommandWithoutPositionalsIsUnknown)
+{
+    Command noPositionals("plain");
+    noPositionals.withFlagArgument(FlagArgument("--all", "-a"));
+    ContextBuilder builder;
+
+    EXPECT_THROW(parser.parseArguments(noPositionals, std::vector<std::string>{"stray"}, builder),
+                 parsing::UnknownInputException);
+}
+
+TEST_F(ParserTestSociable, SurplusPositionalIsStillAParseError)
+{
+    EXPECT_THROW(parse({"first", "second"}), parsing::ParseException);
+}
+
+class ParserGroupTestSociable : public ParserTestSociable
+{
+public:
+    Command grouped{"grouped"};
+
+    void SetUp() override
+    {
+        grouped
+            .withExclusiveGroup(OptionArgument<int>("--fast", "n"), OptionArgument<int>("--slow", "n"))
+            .withInclusiveGroup(OptionArgument<std::string>("--user", "name"),
+                                OptionArgument<std::string>("--password", "secret"))
+            .withOptionArgument(OptionArgument<int>("--level", "n").withRequired(true));
+        grouped.buildArgumentIndex();
+    }
+
+    void parseGrouped(const std::vector<std::string> &inputs)
+    {
+        ContextBuilder builder;
+        parser.parseArguments(grouped, inputs, builder);
+    }
+};
+
+TEST_F(ParserGroupTestSociable, ValidInputPassesAllGroupChecks)
+{
+    EXPECT_NO_THROW(
+        parseGrouped({"--fast", "1", "--user", "me", "--password", "pw", "--level", "2"}));
+}
+
+TEST_F(ParserGroupTestSociable, TwoExclusiveArgumentsThrow)
+{
+    EXPECT_THROW(parseGrouped({"--fast", "1", "--slow", "2", "--user", "me", "--password", "pw",
+                               "--level", "2"}),
+                 parsing::GroupParseException);
+}
+
+TEST_F(ParserGroupTestSociable, IncompleteInclusiveGroupThrows)
+{
+    EXPECT_THROW(parseGrouped({"--user", "me", "--level", "2"}), parsing::GroupParseException);
+}
+
+TEST_F(ParserGroupTestSociable, MissingRequiredArgumentThrows)
+{
+    try
+    {
+        parseGrouped({"--user", "me", "--password", "pw"});
+        FAIL() << "Expected a ParseException";
+    }
+    catch (const parsing::ParseException &e)
+    {
+        EXPECT_STREQ(e.what(), "Required argument --level is missing");
+    }
+}
+
+TEST(CommandArgumentGroups, ArgumentAfterExclusiveGroupStartsNewPlainGroup)
+{
+    Command cmd("cmd");
+    cmd.withOptionArgument(OptionArgument<int>("--a", "n"))
+        .withExclusiveGroup(FlagArgument("--x"), FlagArgument("--y"))
+        .withFlagArgument(FlagArgument("--z"));
+
+    const auto &groups = cmd.getArgumentGroups();
+    ASSERT_EQ(groups.size(), 3u);
+    EXPECT_EQ(groups[1]->getArguments().size(), 2u);
+    ASSERT_EQ(groups[2]->getArguments().size(), 1u);
+    EXPECT_EQ(groups[2]->getArguments()[0]->getName(), "--z");
+    EXPECT_FALSE(groups[2]->isExclusive());
+    EXPECT_FALSE(groups[2]->isInclusive());
+}
+
+TEST(CommandArgumentGroups, ArgumentAfterInclusiveGroupStartsNewPlainGroup)
+{
+    Command cmd("cmd");
+    cmd.withOptionArgument(OptionArgument<int>("--a", "n"))
+        .withInclusiveGroup(FlagArgument("--x"), FlagArgument("--y"))
+        .withFlagArgument(FlagArgument("--z"));
+
+    const auto &groups = cmd.getArgumentGroups();
+    ASSERT_EQ(groups.size(), 3u);
+    EXPECT_EQ(groups[1]->getArguments().size(), 2u);
+    EXPECT_FALSE(groups[2]->isInclusive());
+}
+
+TEST(ArgumentIndexMasks, RequiredAndGroupSlotsArePrecomputed)
+{
+    Command cmd("cmd");
+    cmd.withOptionArgument(OptionArgument<int>("--a", "n").withRequired(true))
+        .withPositionalArgument(PositionalArgument<std::string>("file"))
+        .withExclusiveGroup(FlagArgument("--x"), FlagArgument("--y"));
+    cmd.buildArgumentIndex();
+    const auto &index = cmd.getArgumentIndex();
+
+    EXPECT_EQ(index.getRequiredSlots().count(), 2u);
+    EXPECT_TRUE(index.getRequiredSlots().contains(0));
+    EXPECT_TRUE(index.getRequiredSlots().contains(1));
+    ASSERT_EQ(index.getGroupMasks().size(), 1u);
+    EXPECT_TRUE(index.getGroupMasks()[0].members.contains(2));
+    EXPECT_TRUE(index.getGroupMasks()[0].members.contains(3));
+    EXPECT_EQ(index.getGroupMasks()[0].members.count(), 2u);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "commands/suggestion_index.h"
+
+using namespace cli::commands;
+
+namespace
+{
+// the closest names found by comparing against every name
+std::vector<SuggestionIndex::Suggestion> referenceClosest(const std::vector<std::string> &names,
+                                                          std::string_view name, size_t limit,
+                                                          size_t maxDistance)
+{
+    std::vector<SuggestionIndex::Suggestion> matches;
+    for (const auto &candidate : names)
+    {
+        if (const size_t dist = SuggestionIndex::distance(name, candidate); dist <= maxDistance)
+        {
+            matches.push_back({candidate, dist});
+        }
+    }
+    std::ranges::sort(matches, {}, [](const auto &match) {
+        return std::tie(match.distance, match.name);
+    });
+    matches.resize(std::min(matches.size(), limit));
+    return matches;
+}
+} // namespace
+
+TEST(SuggestionIndexTest, DistanceIsTheLevenshteinDistance)
+{
+    EXPECT_EQ(SuggestionIndex::distance("", ""), 0);
+    EXPECT_EQ(SuggestionIndex::distance("abc", ""), 3);
+    EXPECT_EQ(SuggestionIndex::distance("kitten", "sitting"), 3);
+    EXPECT_EQ(SuggestionIndex::distance("status", "stauts"), 2);
+    EXPECT_EQ(SuggestionIndex::distance("--verbose", "--verbos"), 1);
+}
+
+TEST(SuggestionIndexTest, BoundedDistanceStopsAboveTheBound)
+{
+    EXPECT_GT(SuggestionIndex::distance("kitten", "sitting", 2), 2);
+    EXPECT_EQ(SuggestionIndex::distance("kitten", "sitting", 3), 3);
+    EXPECT_GT(SuggestionIndex::distance("a", "abcdef", 1), 1);
+}
+
+TEST(SuggestionIndexTest, ClosestNamesAreSortedByDistanceThenName)
+{
+    SuggestionIndex index;
+    for (const auto *name : {"remove", "rename", "remote", "reset", "branch", "remote"})
+    {
+        index.insert(name);
+    }
+
+    const auto matches = index.closest("remte", 5, 3);
+
+    EXPECT_EQ(index.size(), 5);
+    ASSERT_EQ(matches.size(), 4);
+    EXPECT_EQ(matches[0].name, "remote");
+    EXPECT_EQ(matches[0].distance, 1);
+    EXPECT_EQ(matches[1].name, "remove");
+    EXPECT_EQ(matches[1].distance, 2);
+    EXPECT_EQ(matches[2].name, "rename");
+    EXPECT_EQ(matches[3].name, "reset");
+    EXPECT_EQ(index.closest("remte", 5).size(), 1);
+}
+
+TEST(SuggestionIndexTest, RespectsLimitAndMaxDistance)
+{
+    SuggestionIndex index;
+    for (const auto *name : {"add", "and", "all", "odd"})
+    {
+        index.insert(name);
+    }
+
+    EXPECT_EQ(index.closest("adx", 3).size(), 1);
+    EXPECT_EQ(index.closest("adx", 2, 2).size(), 2);
+    EXPECT_TRUE(index.closest("zzz", 3).empty());
+    EXPECT_EQ(index.closest("zzz", 3, 3).size(), 3);
+    EXPECT_TRUE(SuggestionIndex().closest("add", 3).empty());
+}
+
+TEST(SuggestionIndexTest, MatchesLinearScanOnLargeSets)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> letter('a', 'f');
+    std::uniform_int_distribution<size_t> length(1, 10);
+    std::vector<std::string> names(20000);
+    for (auto &name : names)
+    {
+        name.resize(length(rng));
+        std::ranges::generate(name, [&] { return static_cast<char>(letter(rng)); });
+    }
+    std::ranges::sort(names);
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    SuggestionIndex index;
+    for (const auto &name : names)
+    {
+        index.insert(name);
+    }
+
+    for (int i = 0; i < 200; ++i)
+    {
+        std::string query(length(rng), 'a');
+        std::ranges::generate(query, [&] { return static_cast<char>(letter(rng)); });
+        const size_t maxDistance = SuggestionIndex::defaultMaxDistance(query);
+
+        const auto expected = referenceClosest(names, query, 5, maxDistance);
+        const auto actual = index.closest(query, 5);
+
+        ASSERT_EQ(actual.size(), expected.size()) << query;
+        for (size_t j = 0; j < expected.size(); ++j)
+        {
+            EXPECT_EQ(actual[j].name, expected[j].name) << query;
+            EXPECT_EQ(actual[j].distance, expected[j].distance) << query;
+        }
+    }
+}
+
+TEST(SuggestionIndexTest, FormatsSuggestionsAsSentence)
+{
+    EXPECT_EQ(formatSuggestions({}), "");
+    EXPECT_EQ(formatSuggestions({"add"}), "Did you mean 'add'?");
+    EXPECT_EQ(formatSuggestions({"add", "all"}), "Did you mean 'add' or 'all'?");
+    EXPECT_EQ(formatSuggestions({"add", "all", "and"}), "Did you mean 'add', 'all' or 'and'?");
+}
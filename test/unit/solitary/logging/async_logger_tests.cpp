@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+
+#include <future>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "logging/async_logger.h"
+
+using namespace cli::logging;
+
+// Handler that records the messages and can hold the writer thread inside emit
+class RecordingHandler : public AbstractHandler
+{
+public:
+    struct State
+    {
+        std::mutex mutex;
+        std::vector<std::string> messages;
+        bool holdFirst = false;
+        std::promise<void> entered;
+        std::shared_future<void> release;
+    };
+
+    explicit RecordingHandler(std::shared_ptr<State> state) : state(std::move(state)) {}
+
+    void emit(const LogRecord &record) const override
+    {
+        bool hold = false;
+        {
+            std::scoped_lock lock(state->mutex);
+            state->messages.push_back(record.message);
+            hold = state->holdFirst;
+            state->holdFirst = false;
+        }
+        if (hold)
+        {
+            state->entered.set_value();
+            state->release.wait();
+        }
+    }
+
+private:
+    std::shared_ptr<State> state;
+};
+
+class AsyncLoggerTestSolitary : public ::testing::Test
+{
+public:
+    std::shared_ptr<RecordingHandler::State> state = std::make_shared<RecordingHandler::State>();
+
+    void attach(AsyncLogger &logger) const
+    {
+        logger.removeAllHandlers();
+        logger.addHandler(std::make_unique<RecordingHandler>(state));
+    }
+
+    // blocks the writer thread inside the handler for the first message
+    std::promise<void> holdWriter(AsyncLogger &logger) const
+    {
+        std::promise<void> release;
+        state->holdFirst = true;
+        state->release = release.get_future().share();
+        logger.info("first");
+        state->entered.get_future().wait();
+        return release;
+    }
+};
+
+TEST_F(AsyncLoggerTestSolitary, FlushEmitsAllRecordsInOrder)
+{
+    AsyncLogger logger(LogLevel::TRACE);
+    attach(logger);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        logger.info(std::to_string(i));
+    }
+    logger.flush();
+
+    ASSERT_EQ(state->messages.size(), 100U);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(state->messages[i], std::to_string(i));
+    }
+}
+
+TEST_F(AsyncLoggerTestSolitary, DoesNotQueueBelowMinLevel)
+{
+    AsyncLogger logger(LogLevel::ERROR);
+    attach(logger);
+
+    logger.info("ignored message");
+    logger.error("error message");
+    logger.flush();
+
+    EXPECT_EQ(state->messages, std::vector<std::string>{"error message"});
+}
+
+TEST_F(AsyncLoggerTestSolitary, DestructorEmitsRemainingRecords)
+{
+    {
+        AsyncLogger logger(LogLevel::TRACE);
+        attach(logger);
+        logger.info("a");
+        logger.info("b");
+    }
+    EXPECT_EQ(state->messages, (std::vector<std::string>{"a", "b"}));
+}
+
+TEST_F(AsyncLoggerTestSolitary, DropNewestDiscardsMessagesWhileFull)
+{
+    AsyncLogger logger(LogLevel::TRACE, 2, OverflowPolicy::DropNewest);
+    attach(logger);
+
+    auto release = holdWriter(logger);
+    logger.info("b");
+    logger.info("c");
+    logger.info("d");
+    release.set_value();
+    logger.flush();
+
+    EXPECT_EQ(state->messages, (std::vector<std::string>{"first", "b", "c"}));
+    EXPECT_EQ(logger.droppedCount(), 1U);
+}
+
+TEST_F(AsyncLoggerTestSolitary, DropOldestEvictsQueuedMessagesWhileFull)
+{
+    AsyncLogger logger(LogLevel::TRACE, 2, OverflowPolicy::DropOldest);
+    attach(logger);
+
+    auto release = holdWriter(logger);
+    logger.info("b");
+    logger.info("c");
+    logger.info("d");
+    release.set_value();
+    logger.flush();
+
+    EXPECT_EQ(state->messages, (std::vector<std::string>{"first", "c", "d"}));
+    EXPECT_EQ(logger.droppedCount(), 1U);
+}
+
+TEST_F(AsyncLoggerTestSolitary, BlockDeliversEverythingFromManyThreads)
+{
+    constexpr int threadCount = 4;
+    constexpr int perThread = 1000;
+
+    AsyncLogger logger(LogLevel::TRACE, 16, OverflowPolicy::Block);
+    attach(logger);
+    {
+        std::vector<std::jthread> producers;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            producers.emplace_back([&logger] {
+                for (int i = 0; i < perThread; ++i)
+                {
+                    logger.debug("message");
+                }
+            });
+        }
+    }
+    logger.flush();
+
+    EXPECT_EQ(state->messages.size(), static_cast<size_t>(threadCount * perThread));
+    EXPECT_EQ(logger.droppedCount(), 0U);
+}
+
+TEST_F(AsyncLoggerTestSolitary, StreamsAreQueuedOnFlush)
+{
+    AsyncLogger logger(LogLevel::TRACE);
+    attach(logger);
+
+    logger.warning() << "value " << 42 << std::flush;
+    logger.flush();
+
+    EXPECT_EQ(state->messages, std::vector<std::string>{"value 42"});
+}
+
+TEST_F(AsyncLoggerTestSolitary, DeferredMessagesCopyTheirArguments)
+{
+    AsyncLogger logger(LogLevel::TRACE);
+    attach(logger);
+
+    {
+        std::string temporary = "temporary";
+        logger.logDeferred(LogLevel::INFO, "{} {} {}", std::string_view(temporary), 42,
+                           temporary.c_str());
+    }
+    logger.flush();
+
+    EXPECT_EQ(state->messages, std::vector<std::string>{"temporary 42 temporary"});
+}
+
+TEST(RingBufferTest, RoundsCapacityUpToPowerOfTwo)
+{
+    EXPECT_EQ(RingBuffer<int>(0).capacity(), 2U);
+    EXPECT_EQ(RingBuffer<int>(5).capacity(), 8U);
+    EXPECT_EQ(RingBuffer<int>(8).capacity(), 8U);
+}
+
+TEST(RingBufferTest, PushFailsWhenFullAndConsumesInOrder)
+{
+    RingBuffer<int> buffer(2);
+    EXPECT_TRUE(buffer.tryPush(1));
+    EXPECT_TRUE(buffer.tryPush(2));
+    EXPECT_FALSE(buffer.tryPush(3));
+
+    std::vector<int> consumed;
+    while (buffer.tryConsume([&consumed](int value) { consumed.push_back(value); }))
+    {
+    }
+    EXPECT_EQ(consumed, (std::vector<int>{1, 2}));
+    EXPECT_EQ(buffer.pushedCount(), 2U);
+    EXPECT_TRUE(buffer.tryPush(3));
+}
@@ -1,6 +1,13 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <format>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include "logging/formatter.h"
 #include "logging/handler.h"
 #include "logging/logger.h"
@@ -14,6 +21,22 @@ using ::testing::Exactly;
 using ::testing::Field;
 using ::testing::Return;
 
+// Value that counts how often it is formatted
+struct CountedValue
+{
+    inline static int formatCount = 0;
+    int value;
+};
+
+template <> struct std::formatter<CountedValue> : std::formatter<int>
+{
+    auto format(const CountedValue &counted, std::format_context &ctx) const
+    {
+        ++CountedValue::formatCount;
+        return std::formatter<int>::format(counted.value, ctx);
+    }
+};
+
 class LoggerTestSolitary : public ::testing::Test
 {
 public:
@@ -72,6 +95,163 @@ TEST_F(LoggerTestSolitary, LoggerFormatsArgumentsBeforeEmit)
     logger.info("Value={}", val);
 }
 
+TEST_F(LoggerTestSolitary, DisabledLevelDoesNotFormatArguments)
+{
+    Logger logger(LogLevel::INFO);
+    logger.addHandler(std::move(mockHandlerPtr));
+    EXPECT_CALL(*mockHandlerRawPtr, emit(_)).Times(0);
+
+    CountedValue::formatCount = 0;
+    logger.debug("Value={}", CountedValue{42});
+    logger.logDeferred(LogLevel::TRACE, "Value={}", CountedValue{42});
+
+    EXPECT_FALSE(logger.isEnabled(LogLevel::DEBUG));
+    EXPECT_EQ(CountedValue::formatCount, 0);
+}
+
+TEST_F(LoggerTestSolitary, LogDeferredFormatsBeforeEmit)
+{
+    Logger logger(LogLevel::TRACE);
+    logger.addHandler(std::move(mockHandlerPtr));
+
+    EXPECT_CALL(*mockHandlerRawPtr, emit(AllOf(Field(&LogRecord::level, Eq(LogLevel::DEBUG)),
+                                               Field(&LogRecord::message, Eq("Value=42 x")))))
+        .Times(1);
+
+    logger.logDeferred(LogLevel::DEBUG, "Value={} {}", CountedValue{42}, "x");
+}
+
+TEST_F(LoggerTestSolitary, SetLevelUpdatesIsEnabled)
+{
+    Logger logger(LogLevel::TRACE);
+    EXPECT_TRUE(logger.isEnabled(LogLevel::TRACE));
+
+    logger.setLevel(LogLevel::WARNING);
+
+    EXPECT_FALSE(logger.isEnabled(LogLevel::INFO));
+    EXPECT_TRUE(logger.isEnabled(LogLevel::WARNING));
+}
+
+TEST_F(LoggerTestSolitary, LogMacroDoesNotEvaluateArgumentsOfDisabledLevels)
+{
+    Logger logger(LogLevel::INFO);
+    logger.addHandler(std::move(mockHandlerPtr));
+
+    EXPECT_CALL(*mockHandlerRawPtr, emit(AllOf(Field(&LogRecord::level, Eq(LogLevel::INFO)),
+                                               Field(&LogRecord::message, Eq("Value=1")))))
+        .Times(1);
+
+    int evaluations = 0;
+    auto expensive = [&evaluations] { return ++evaluations; };
+    CHAIN_CLI_LOG_DEBUG(logger, "Value={}", expensive());
+    EXPECT_EQ(evaluations, 0);
+
+    CHAIN_CLI_LOG_INFO(logger, "Value={}", expensive());
+    EXPECT_EQ(evaluations, 1);
+}
+
+TEST_F(LoggerTestSolitary, StreamsAreSeparateForEveryThread)
+{
+    Logger logger(LogLevel::TRACE);
+    std::ostream *own = &logger.getStream(LogLevel::INFO);
+    std::ostream *other = nullptr;
+    std::jthread([&logger, &other] { other = &logger.getStream(LogLevel::INFO); }).join();
+
+    EXPECT_EQ(&logger.getStream(LogLevel::INFO), own);
+    EXPECT_NE(other, own);
+}
+
+TEST_F(LoggerTestSolitary, StreamWritesInProgressAreNotSharedBetweenThreads)
+{
+    Logger logger(LogLevel::TRACE);
+    logger.addHandler(std::move(mockHandlerPtr));
+
+    EXPECT_CALL(*mockHandlerRawPtr, emit(Field(&LogRecord::message, Eq("other thread")))).Times(1);
+    EXPECT_CALL(*mockHandlerRawPtr, emit(Field(&LogRecord::message, Eq("this thread")))).Times(1);
+
+    logger.getStream(LogLevel::INFO) << "this ";
+    std::jthread([&logger] { logger.getStream(LogLevel::INFO) << "other thread" << std::flush; })
+        .join();
+    logger.getStream(LogLevel::INFO) << "thread" << std::flush;
+}
+
+class LogStreamBufTest : public ::testing::Test
+{
+public:
+    std::vector<std::pair<LogLevel, std::string>> logged;
+    std::shared_ptr<std::function<void(LogLevel, const std::string &)>> logFuncPtr =
+        std::make_shared<std::function<void(LogLevel, const std::string &)>>(
+            [this](LogLevel lvl, const std::string &msg) { logged.emplace_back(lvl, msg); });
+};
+
+TEST_F(LogStreamBufTest, EmitsBufferedMessageOnFlush)
+{
+    LogStreamBuf buffer(logFuncPtr, LogLevel::INFO, LogLevel::TRACE);
+    std::ostream stream(&buffer);
+
+    stream << "value " << 42 << std::flush;
+    stream << "second" << std::flush;
+    stream << std::flush; // nothing buffered, nothing emitted
+
+    EXPECT_EQ(logged, (std::vector<std::pair<LogLevel, std::string>>{{LogLevel::INFO, "value 42"},
+                                                                     {LogLevel::INFO, "second"}}));
+}
+
+TEST_F(LogStreamBufTest, MessagesLongerThanTheFixedBufferAreKeptWhole)
+{
+    LogStreamBuf buffer(logFuncPtr, LogLevel::INFO, LogLevel::TRACE);
+    std::ostream stream(&buffer);
+
+    const std::string chunk(LogStreamBuf::inlineCapacity / 3, 'x');
+    std::string expected;
+    for (int i = 0; i < 10; ++i)
+    {
+        stream << chunk << 'y';
+        expected += chunk + 'y';
+    }
+    const std::string huge(LogStreamBuf::inlineCapacity * 4, 'z');
+    stream << huge << std::flush;
+    expected += huge;
+    stream << "short" << std::flush;
+
+    ASSERT_EQ(logged.size(), 2U);
+    EXPECT_EQ(logged[0].second, expected);
+    EXPECT_EQ(logged[1].second, "short");
+}
+
+TEST_F(LogStreamBufTest, DisabledLevelDiscardsWithoutBuffering)
+{
+    LogStreamBuf buffer(logFuncPtr, LogLevel::DEBUG, LogLevel::INFO);
+    std::ostream stream(&buffer);
+
+    stream << "ignored " << 42 << std::string(LogStreamBuf::inlineCapacity * 2, 'x') << std::flush;
+    EXPECT_TRUE(stream.good());
+    EXPECT_TRUE(logged.empty());
+
+    buffer.setMinLevel(LogLevel::DEBUG);
+    stream << "emitted" << std::flush;
+    EXPECT_EQ(logged, (std::vector<std::pair<LogLevel, std::string>>{{LogLevel::DEBUG, "emitted"}}));
+}
+
+TEST_F(LogStreamBufTest, DisablingTheLevelDropsThePendingMessage)
+{
+    LogStreamBuf buffer(logFuncPtr, LogLevel::DEBUG, LogLevel::TRACE);
+    std::ostream stream(&buffer);
+
+    stream << "pending";
+    buffer.setMinLevel(LogLevel::INFO);
+    buffer.setMinLevel(LogLevel::TRACE);
+    stream << "next" << std::flush;
+
+    EXPECT_EQ(logged, (std::vector<std::pair<LogLevel, std::string>>{{LogLevel::DEBUG, "next"}}));
+}
+
+TEST(DisabledStreamTest, DiscardsValuesAndManipulators)
+{
+    const DisabledStream stream;
+    EXPECT_EQ(&(stream << 42 << "text" << std::hex << std::setw(4) << std::endl), &stream);
+}
+
 TEST_F(LoggerTestSolitary, ConvenienceMethodsUsesCorrectLevel)
 {
     Logger logger(LogLevel::TRACE);
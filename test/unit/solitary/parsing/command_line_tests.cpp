@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parsing/command_line.h"
+#include "parsing/parse_exception.h"
+
+using namespace cli::parsing;
+
+namespace
+{
+std::vector<std::string> split(std::string_view line)
+{
+    std::pmr::string storage;
+    std::pmr::vector<std::string_view> arguments;
+    splitCommandLine(line, storage, arguments);
+    return {arguments.begin(), arguments.end()};
+}
+} // namespace
+
+TEST(CommandLineTest, SplitsOnWhitespace)
+{
+    EXPECT_EQ(split("  cmd  -t 4\tfile\r"), (std::vector<std::string>{"cmd", "-t", "4", "file"}));
+}
+
+TEST(CommandLineTest, BlankLineHasNoArguments)
+{
+    EXPECT_TRUE(split("").empty());
+    EXPECT_TRUE(split(" \t ").empty());
+}
+
+TEST(CommandLineTest, QuotesKeepWhitespace)
+{
+    EXPECT_EQ(split("cmd 'a b' \"c  d\""), (std::vector<std::string>{"cmd", "a b", "c  d"}));
+}
+
+TEST(CommandLineTest, AdjacentPartsFormOneArgument)
+{
+    EXPECT_EQ(split("--name=\"a b\"'c'd"), (std::vector<std::string>{"--name=a bcd"}));
+}
+
+TEST(CommandLineTest, EmptyQuotesAreAnEmptyArgument)
+{
+    EXPECT_EQ(split("cmd \"\" ''"), (std::vector<std::string>{"cmd", "", ""}));
+}
+
+TEST(CommandLineTest, EscapesAreResolved)
+{
+    EXPECT_EQ(split(R"(a\ b "q\"uote\\" 'no\escape' c\d)"),
+              (std::vector<std::string>{"a b", "q\"uote\\", "no\\escape", "cd"}));
+}
+
+TEST(CommandLineTest, CommentEndsTheLine)
+{
+    EXPECT_EQ(split("cmd a#b # rest"), (std::vector<std::string>{"cmd", "a#b"}));
+    EXPECT_TRUE(split("# only a comment").empty());
+}
+
+TEST(CommandLineTest, UnterminatedQuoteThrows)
+{
+    EXPECT_THROW(split("cmd \"open"), CommandLineSyntaxException);
+    EXPECT_THROW(split("cmd 'open"), CommandLineSyntaxException);
+}
+
+TEST(CommandLineTest, PreviousContentIsReplaced)
+{
+    std::pmr::string storage;
+    std::pmr::vector<std::string_view> arguments;
+
+    splitCommandLine("first line", storage, arguments);
+    splitCommandLine("second", storage, arguments);
+
+    ASSERT_EQ(arguments.size(), 1u);
+    EXPECT_EQ(arguments[0], "second");
+}
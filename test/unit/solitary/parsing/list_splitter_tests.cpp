@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parsing/list_splitter.h"
+
+using namespace cli::parsing;
+
+namespace
+{
+// the stringstream based splitting the parser used before, kept as the reference behavior
+std::vector<std::string> referenceSplit(const std::string &input, char delimiter)
+{
+    std::stringstream ss(input);
+    std::string token;
+    std::vector<std::string> values;
+
+    while (std::getline(ss, token, delimiter))
+    {
+        token.erase(token.begin(), std::ranges::find_if(
+                                       token, [](unsigned char ch) { return !std::isspace(ch); }));
+        token.erase(std::ranges::find_if(token | std::views::reverse,
+                                         [](unsigned char ch) { return !std::isspace(ch); })
+                        .base(),
+                    token.end());
+
+        if (!token.empty())
+        {
+            values.push_back(token);
+        }
+    }
+    return values;
+}
+
+std::vector<std::string> split(std::string_view input, char delimiter)
+{
+    std::vector<std::string> values;
+    forEachListValue(input, delimiter,
+                     [&](std::string_view value) { values.emplace_back(value); });
+    return values;
+}
+} // namespace
+
+TEST(ListSplitterTest, SplitsAndTrimsValues)
+{
+    EXPECT_EQ(split(" 1 ,,\t2 , 3,", ','), (std::vector<std::string>{"1", "2", "3"}));
+}
+
+TEST(ListSplitterTest, EmptyAndBlankInputsHaveNoValues)
+{
+    EXPECT_TRUE(split("", ',').empty());
+    EXPECT_TRUE(split(" \t\n", ',').empty());
+    EXPECT_TRUE(split(",,,", ',').empty());
+}
+
+TEST(ListSplitterTest, InnerWhitespaceIsKept)
+{
+    EXPECT_EQ(split("a b,\vc\fd\r", ','), (std::vector<std::string>{"a b", "c\fd"}));
+}
+
+TEST(ListSplitterTest, ValuesAreViewsIntoTheInput)
+{
+    const std::string input = "alpha, beta";
+    std::vector<std::string_view> views;
+
+    forEachListValue(input, ',', [&](std::string_view value) { views.push_back(value); });
+
+    ASSERT_EQ(views.size(), 2u);
+    EXPECT_EQ(views[0].data(), input.data());
+    EXPECT_EQ(views[1].data(), input.data() + 7);
+}
+
+TEST(ListSplitterTest, ValuesSpanningBlockBoundariesAreJoined)
+{
+    const std::string longValue(150, 'x');
+    const std::string input = std::string(60, ' ') + longValue + std::string(70, ' ') + ";y";
+
+    EXPECT_EQ(split(input, ';'), (std::vector<std::string>{longValue, "y"}));
+}
+
+TEST(ListSplitterTest, WhitespaceDelimiterIsSupported)
+{
+    EXPECT_EQ(split("  1  2\t3 ", ' '), referenceSplit("  1  2\t3 ", ' '));
+}
+
+TEST(ListSplitterTest, ScalarAndVectorizedMasksAgree)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::string block(detail::blockSize, '\0');
+
+    for (int round = 0; round < 1000; ++round)
+    {
+        std::ranges::generate(block, [&] { return static_cast<char>(byte(rng)); });
+        const char delimiter = block[static_cast<size_t>(round) % block.size()];
+
+        auto expected = detail::scalarBlockMasks(block.data(), block.size(), delimiter);
+        auto actual = detail::blockMasks(block.data(), block.size(), delimiter);
+
+        EXPECT_EQ(actual.delimiters, expected.delimiters);
+        EXPECT_EQ(actual.content, expected.content);
+    }
+}
+
+TEST(ListSplitterTest, MatchesReferenceOnRandomInputs)
+{
+    const std::string alphabet = "ab1,;  \t\n\v\f\r\x85\xa0-";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    std::uniform_int_distribution<size_t> length(0, 300);
+
+    for (int round = 0; round < 2000; ++round)
+    {
+        std::string input(length(rng), ' ');
+        std::ranges::generate(input, [&] { return alphabet[pick(rng)]; });
+        const char delimiter = round % 2 == 0 ? ',' : ';';
+
+        ASSERT_EQ(split(input, delimiter), referenceSplit(input, delimiter)) << input;
+    }
+}
+
+TEST(ListSplitterTest, MatchesReferenceOnLargeIdList)
+{
+    std::string input;
+    for (int id = 0; id < 50000; ++id)
+    {
+        input += std::to_string(id);
+        input += id % 3 == 0 ? " , " : ",";
+    }
+
+    EXPECT_EQ(split(input, ','), referenceSplit(input, ','));
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "parsing/parse_exception.h"
+#include "parsing/parser_utils.h"
+
+using namespace cli::parsing;
+
+struct Point
+{
+    int x{0};
+    int y{0};
+
+    friend std::istream &operator>>(std::istream &is, Point &p)
+    {
+        char sep;
+        return is >> p.x >> sep >> p.y;
+    }
+};
+
+TEST(ParseHelperTestSolitary, ParsesIntegers)
+{
+    EXPECT_EQ(ParseHelper::parse<int>("42"), 42);
+    EXPECT_EQ(ParseHelper::parse<int>("-17"), -17);
+    EXPECT_EQ(ParseHelper::parse<int>("+8"), 8);
+    EXPECT_EQ(ParseHelper::parse<int>(" 3"), 3);
+    EXPECT_EQ(ParseHelper::parse<std::uint64_t>("18446744073709551615"),
+              std::numeric_limits<std::uint64_t>::max());
+}
+
+TEST(ParseHelperTestSolitary, RejectsInvalidIntegers)
+{
+    EXPECT_THROW(ParseHelper::parse<int>(""), TypeParseException);
+    EXPECT_THROW(ParseHelper::parse<int>("12abc"), TypeParseException);
+    EXPECT_THROW(ParseHelper::parse<int>("4 "), TypeParseException);
+    EXPECT_THROW(ParseHelper::parse<int>("+-4"), TypeParseException);
+    EXPECT_THROW(ParseHelper::parse<int>("1.5"), TypeParseException);
+    EXPECT_THROW(ParseHelper::parse<short>("70000"), TypeParseException);
+    EXPECT_THROW(ParseHelper::parse<unsigned>("-1"), TypeParseException);
+}
+
+TEST(ParseHelperTestSolitary, ParsesFloatingPoint)
+{
+    EXPECT_DOUBLE_EQ(ParseHelper::parse<double>("3.25"), 3.25);
+    EXPECT_DOUBLE_EQ(ParseHelper::parse<double>("-1e3"), -1000.0);
+    EXPECT_FLOAT_EQ(ParseHelper::parse<float>("+0.5"), 0.5f);
+    EXPECT_THROW(ParseHelper::parse<double>("1.2.3"), TypeParseException);
+    EXPECT_THROW(ParseHelper::parse<double>("abc"), TypeParseException);
+}
+
+TEST(ParseHelperTestSolitary, ParsesBool)
+{
+    EXPECT_TRUE(ParseHelper::parse<bool>("1"));
+    EXPECT_TRUE(ParseHelper::parse<bool>("true"));
+    EXPECT_FALSE(ParseHelper::parse<bool>("0"));
+    EXPECT_FALSE(ParseHelper::parse<bool>("false"));
+    EXPECT_THROW(ParseHelper::parse<bool>("yes"), TypeParseException);
+}
+
+TEST(ParseHelperTestSolitary, ExceptionCarriesInputAndType)
+{
+    try
+    {
+        ParseHelper::parse<int>("nope");
+        FAIL() << "Expected TypeParseException";
+    }
+    catch (const TypeParseException &e)
+    {
+        EXPECT_EQ(e.getInput(), "nope");
+        EXPECT_EQ(e.getTargetType(), typeid(int));
+    }
+}
+
+TEST(ParseHelperTestSolitary, StringsAndCharsAreKeptAsIs)
+{
+    EXPECT_EQ(ParseHelper::parse<std::string>(" spaced value "), " spaced value ");
+    EXPECT_EQ(ParseHelper::parse<char>("x"), 'x');
+    EXPECT_THROW(ParseHelper::parse<char>("xy"), TypeParseException);
+}
+
+TEST(ParseHelperTestSolitary, UserTypesUseStreamOperator)
+{
+    auto p = ParseHelper::parse<Point>("3,4");
+
+    EXPECT_EQ(p.x, 3);
+    EXPECT_EQ(p.y, 4);
+    EXPECT_THROW(ParseHelper::parse<Point>("3"), TypeParseException);
+}
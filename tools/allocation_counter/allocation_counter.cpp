@@ -0,0 +1,159 @@
+// Copyright 2025 Dominik Czekai
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#include <malloc.h>
+#endif
+
+namespace cli::allocations
+{
+namespace
+{
+std::atomic<uint64_t> allocationCount{0};
+std::atomic<uint64_t> allocatedBytes{0};
+
+// plain thread locals without dynamic initialization, so they can be used by operator new at
+// any time, even while a thread is started or destroyed
+thread_local uint64_t threadAllocationCount = 0;
+thread_local uint64_t threadAllocatedBytes = 0;
+} // namespace
+
+namespace detail
+{
+void *countedAllocate(std::size_t size, std::size_t alignment)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    ++threadAllocationCount;
+    threadAllocatedBytes += size;
+    if (size == 0)
+    {
+        size = 1;
+    }
+    void *memory = nullptr;
+    if (alignment <= alignof(std::max_align_t))
+    {
+        memory = std::malloc(size);
+    }
+    else
+    {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+        memory = _aligned_malloc(size, alignment);
+#else
+        // aligned_alloc requires the size to be a multiple of the alignment
+        memory = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+    }
+    if (!memory)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void countedFree(void *memory, std::size_t alignment) noexcept
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    if (alignment > alignof(std::max_align_t))
+    {
+        _aligned_free(memory);
+        return;
+    }
+#else
+    (void)alignment;
+#endif
+    std::free(memory);
+}
+} // namespace detail
+
+AllocationCount processAllocations() noexcept
+{
+    return AllocationCount{allocationCount.load(std::memory_order_relaxed),
+                           allocatedBytes.load(std::memory_order_relaxed)};
+}
+
+AllocationCount threadAllocations() noexcept
+{
+    return AllocationCount{threadAllocationCount, threadAllocatedBytes};
+}
+} // namespace cli::allocations
+
+// every allocation of the process goes through these, so allocations of the library and the
+// standard library are counted alike
+void *operator new(std::size_t size)
+{
+    return cli::allocations::detail::countedAllocate(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t size)
+{
+    return cli::allocations::detail::countedAllocate(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return cli::allocations::detail::countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return cli::allocations::detail::countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *memory) noexcept
+{
+    cli::allocations::detail::countedFree(memory, alignof(std::max_align_t));
+}
+
+void operator delete[](void *memory) noexcept
+{
+    cli::allocations::detail::countedFree(memory, alignof(std::max_align_t));
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    cli::allocations::detail::countedFree(memory, alignof(std::max_align_t));
+}
+
+void operator delete[](void *memory, std::size_t) noexcept
+{
+    cli::allocations::detail::countedFree(memory, alignof(std::max_align_t));
+}
+
+void operator delete(void *memory, std::align_val_t alignment) noexcept
+{
+    cli::allocations::detail::countedFree(memory, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *memory, std::align_val_t alignment) noexcept
+{
+    cli::allocations::detail::countedFree(memory, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *memory, std::size_t, std::align_val_t alignment) noexcept
+{
+    cli::allocations::detail::countedFree(memory, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *memory, std::size_t, std::align_val_t alignment) noexcept
+{
+    cli::allocations::detail::countedFree(memory, static_cast<std::size_t>(alignment));
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2025 Dominik Czekai
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace cli::allocations
+{
+/// @brief Number of allocations and allocated bytes since the start of a process or thread.
+struct AllocationCount
+{
+    uint64_t allocations;
+    uint64_t bytes;
+};
+
+/// @brief Read the counters of the replaced global operator new for all threads.
+/// @details Every executable linking the allocation_counter target replaces the global operator
+/// new, so allocations of the standard library are counted as well.
+/// @return The allocations made so far by all threads.
+AllocationCount processAllocations() noexcept;
+
+/// @brief Read the counters of the replaced global operator new for the calling thread.
+/// @return The allocations made so far by the calling thread.
+AllocationCount threadAllocations() noexcept;
+
+/// @brief Counts the heap allocations of the current thread while it is alive.
+/// @details Allocations of other threads are not counted.
+class AllocationCounter
+{
+public:
+    AllocationCounter() noexcept : atStart(threadAllocations()) {}
+
+    /// @brief Number of allocations since the counter was created.
+    [[nodiscard]] size_t allocations() const noexcept
+    {
+        return static_cast<size_t>(threadAllocations().allocations - atStart.allocations);
+    }
+
+    /// @brief Number of bytes requested since the counter was created.
+    [[nodiscard]] size_t bytes() const noexcept
+    {
+        return static_cast<size_t>(threadAllocations().bytes - atStart.bytes);
+    }
+
+private:
+    AllocationCount atStart;
+};
+
+/// @brief Count the heap allocations made by the current thread while running a block.
+/// @param block The code to run.
+/// @return The number of allocations.
+template <typename Block> size_t countAllocations(Block &&block)
+{
+    const AllocationCounter counter;
+    std::forward<Block>(block)();
+    return counter.allocations();
+}
+} // namespace cli::allocations